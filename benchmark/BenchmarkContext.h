@@ -0,0 +1,56 @@
+#pragma once
+
+#include "module/ApplicationContextBase.h"
+#include "os/path.h"
+#include "string/predicate.h"
+
+namespace benchmark
+{
+
+/**
+ * Application context of the headless benchmark.
+ *
+ * Settings and caches are kept in a separate folder, such that every run
+ * starts from the defaults and never touches the user's own settings.
+ * Only the core modules are loaded, the plugins/ folder contains modules
+ * depending on the user interface which is not available here.
+ */
+class BenchmarkContext :
+    public radiant::ApplicationContextBase
+{
+private:
+    std::string _settingsPath;
+
+public:
+    void setSettingsPath(const std::string& path)
+    {
+        _settingsPath = os::standardPathWithSlash(path);
+    }
+
+    std::string getSettingsPath() const override
+    {
+        return _settingsPath;
+    }
+
+    std::string getCacheDataPath() const override
+    {
+        return _settingsPath + "cache/";
+    }
+
+    std::vector<std::string> getLibraryPaths() const override
+    {
+        std::vector<std::string> paths;
+
+        for (const auto& path : ApplicationContextBase::getLibraryPaths())
+        {
+            if (!string::ends_with(path, PLUGINS_DIR))
+            {
+                paths.push_back(path);
+            }
+        }
+
+        return paths;
+    }
+};
+
+}
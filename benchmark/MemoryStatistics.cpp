@@ -0,0 +1,108 @@
+#include "MemoryStatistics.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::atomic<std::size_t> _numAllocations(0);
+    std::atomic<std::size_t> _allocatedBytes(0);
+
+    void* allocate(std::size_t size)
+    {
+        _numAllocations.fetch_add(1, std::memory_order_relaxed);
+        _allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+        // malloc(0) is allowed to return nullptr, operator new is not
+        if (auto* pointer = std::malloc(size > 0 ? size : 1))
+        {
+            return pointer;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    std::size_t getPeakResidentBytes()
+    {
+#if defined(WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return counters.PeakWorkingSetSize;
+        }
+
+        return 0;
+#else
+        rusage usage;
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+#if defined(__APPLE__)
+        // macOS reports bytes, Linux reports kilobytes
+        return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+}
+
+namespace benchmark
+{
+
+MemoryStatistics MemoryStatistics::Sample()
+{
+    MemoryStatistics statistics;
+
+    statistics.numAllocations = _numAllocations.load();
+    statistics.allocatedBytes = _allocatedBytes.load();
+    statistics.peakResidentBytes = getPeakResidentBytes();
+
+    return statistics;
+}
+
+}
+
+// Replacement allocation functions, the nothrow variants are forwarding
+// to these by default. Over-aligned allocations are not counted.
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+namespace benchmark
+{
+
+/**
+ * Process-wide memory statistics sampled around each scenario.
+ *
+ * The allocation counters are maintained by the replacement operator new
+ * of this executable. On ELF platforms it also receives the allocations
+ * of the loaded modules, on Windows each DLL has its own allocator and
+ * only the allocations made by the benchmark itself are counted.
+ */
+struct MemoryStatistics
+{
+    std::size_t numAllocations = 0;
+    std::size_t allocatedBytes = 0;
+
+    // Peak resident set size of the process in bytes, 0 if unknown
+    std::size_t peakResidentBytes = 0;
+
+    static MemoryStatistics Sample();
+};
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+// Command line settings the scenarios are depending on
+struct Options
+{
+    // The map file loaded by the map scenarios
+    std::string mapPath;
+
+    // The prefab pasted by the paste scenario, the map itself if empty
+    std::string prefabPath;
+
+    // Folder the save scenarios are writing to
+    std::string outputPath;
+};
+
+/**
+ * A named operation whose run() function is timed by the benchmark.
+ *
+ * The prepare() and cleanup() functions are invoked before and after
+ * each iteration without being measured, they restore the state
+ * the next iteration is starting from.
+ */
+struct Scenario
+{
+    std::string name;
+    std::string description;
+
+    // Scenarios operating on the map are skipped when no map is given
+    bool needsMap = false;
+
+    std::function<void()> prepare;
+    std::function<void()> run;
+    std::function<void()> cleanup;
+};
+
+// Returns all available scenarios, in the order they are run by default
+std::vector<Scenario> createScenarios(const Options& options);
+
+// Loads the given map, including all models loaded in the background
+void loadMap(const std::string& mapPath);
+
+}
@@ -0,0 +1,181 @@
+#include "Scenario.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "ibrush.h"
+#include "icommandsystem.h"
+#include "ideclmanager.h"
+#include "ifilter.h"
+#include "imap.h"
+#include "imodelcache.h"
+#include "iselectable.h"
+#include "iselection.h"
+#include "iundo.h"
+#include "os/path.h"
+#include "registry/registry.h"
+
+namespace benchmark
+{
+
+namespace
+{
+    // Every n-th worldspawn brush is used to carve the other brushes
+    constexpr std::size_t CSG_SUBTRACT_BRUSH_STRIDE = 64;
+
+    // The prefab is pasted this many times per run, each paste conflicting with the previous ones
+    constexpr std::size_t PREFAB_PASTES_PER_RUN = 4;
+
+    const char* const RKEY_EMIT_CSG_SUBTRACT_WARNING = "user/ui/brush/emitCSGSubtractWarning";
+
+    void deselectAll()
+    {
+        GlobalSelectionSystem().setSelectedAll(false);
+    }
+
+    void undo()
+    {
+        GlobalMapModule().getUndoSystem().undo();
+    }
+
+    void selectBrushesForSubtraction()
+    {
+        deselectAll();
+
+        std::size_t index = 0;
+
+        GlobalMapModule().findOrInsertWorldspawn()->foreachNode([&](const scene::INodePtr& child)
+        {
+            if (Node_isBrush(child) && index++ % CSG_SUBTRACT_BRUSH_STRIDE == 0)
+            {
+                Node_setSelected(child, true);
+            }
+
+            return true;
+        });
+
+        // The first run shows a notification and changes the registry, keep that out
+        registry::setValue(RKEY_EMIT_CSG_SUBTRACT_WARNING, false);
+    }
+
+    void toggleAllFilters()
+    {
+        std::vector<std::string> filters;
+        GlobalFilterSystem().forEachFilter([&](const std::string& name) { filters.push_back(name); });
+
+        for (const auto& filter : filters)
+        {
+            auto state = GlobalFilterSystem().getFilterState(filter);
+
+            GlobalFilterSystem().setFilterState(filter, !state);
+            GlobalFilterSystem().setFilterState(filter, state);
+        }
+    }
+}
+
+void loadMap(const std::string& mapPath)
+{
+    // Don't ask to save the changes of a previous scenario
+    GlobalMapModule().setModified(false);
+
+    GlobalCommandSystem().executeCommand("OpenMap", { cmd::Argument(mapPath) });
+
+    if (GlobalMapModule().isUnnamed())
+    {
+        throw std::runtime_error("Failed to load the map " + mapPath);
+    }
+
+    // Models are parsed on worker threads, the map is complete after they're delivered
+    while (GlobalModelCache().getNumPendingModels() > 0)
+    {
+        if (!GlobalModelCache().processLoadedModels())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+std::vector<Scenario> createScenarios(const Options& options)
+{
+    std::vector<Scenario> scenarios;
+
+    scenarios.push_back(Scenario{ "load-map", "Loads the map including its models", true,
+        {},
+        [=]() { loadMap(options.mapPath); },
+        {}
+    });
+
+    auto savePath = os::standardPathWithSlash(options.outputPath) + "benchmark.map";
+
+    scenarios.push_back(Scenario{ "save-map", "Writes the map to a file outside the project", true,
+        {},
+        [=]() { GlobalCommandSystem().executeCommand("SaveAutomaticBackup", { cmd::Argument(savePath) }); },
+        {}
+    });
+
+    scenarios.push_back(Scenario{ "parse-decls", "Reparses all declarations in the VFS", false,
+        {},
+        []() { GlobalDeclarationManager().reloadDeclarations(); },
+        {}
+    });
+
+    scenarios.push_back(Scenario{ "select-transform", "Selects everything, then moves and rotates it", true,
+        deselectAll,
+        []()
+        {
+            GlobalSelectionSystem().setSelectedAll(true);
+            GlobalCommandSystem().executeCommand("MoveSelection", { cmd::Argument(Vector3(64, 32, 16)) });
+            GlobalCommandSystem().executeCommand("RotateSelectedEulerXYZ", { cmd::Argument(Vector3(0, 0, 15)) });
+        },
+        []()
+        {
+            undo();
+            undo();
+            deselectAll();
+        }
+    });
+
+    scenarios.push_back(Scenario{ "csg-subtract", "Subtracts a sample of worldspawn brushes from the others", true,
+        selectBrushesForSubtraction,
+        []() { GlobalCommandSystem().executeCommand("CSGSubtract"); },
+        []()
+        {
+            undo();
+            deselectAll();
+        }
+    });
+
+    auto prefabPath = options.prefabPath.empty() ? options.mapPath : options.prefabPath;
+
+    scenarios.push_back(Scenario{ "paste-prefab", "Pastes the same prefab into the map several times", true,
+        deselectAll,
+        [=]()
+        {
+            for (std::size_t i = 0; i < PREFAB_PASTES_PER_RUN; ++i)
+            {
+                GlobalCommandSystem().executeCommand(LOAD_PREFAB_AT_CMD,
+                    { cmd::Argument(prefabPath), cmd::Argument(Vector3(0, 0, 0)) });
+            }
+        },
+        []()
+        {
+            for (std::size_t i = 0; i < PREFAB_PASTES_PER_RUN; ++i)
+            {
+                undo();
+            }
+
+            deselectAll();
+        }
+    });
+
+    scenarios.push_back(Scenario{ "filter-toggle", "Toggles every filter on and off again", true,
+        {},
+        toggleAllFilters,
+        {}
+    });
+
+    return scenarios;
+}
+
+}
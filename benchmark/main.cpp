@@ -0,0 +1,373 @@
+/**
+ * Headless benchmark of the WorldEdit core.
+ *
+ * Boots the core module without any user interface or OpenGL context,
+ * runs the named scenarios against the given game setup and map and writes
+ * the timings and memory statistics as JSON, to compare builds against
+ * each other.
+ */
+#include <algorithm>
+#include <clocale>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "iradiant.h"
+#include "imap.h"
+#include "imessagebus.h"
+#include "messages/GameConfigNeededMessage.h"
+#include "module/CoreModule.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "string/convert.h"
+#include "time/StopWatch.h"
+#include "version.h"
+
+#include "BenchmarkContext.h"
+#include "MemoryStatistics.h"
+#include "Scenario.h"
+
+namespace benchmark
+{
+
+namespace
+{
+    const char* const USAGE =
+        "Usage: worldedit-benchmark [options] [scenario...]\n"
+        "\n"
+        "Options:\n"
+        "  --game <name>          Game type as named in the .game files (default: Doom 3)\n"
+        "  --engine-path <path>   Path to the game installation\n"
+        "  --mod-base <path>      Optional fs_game_base folder\n"
+        "  --mod <path>           Optional fs_game folder\n"
+        "  --map <file>           Map used by the map scenarios\n"
+        "  --prefab <file>        Prefab pasted by the paste scenario (default: the map)\n"
+        "  --iterations <n>       Number of measured runs per scenario (default: 3)\n"
+        "  --output <file>        Write the JSON report to this file instead of stdout\n"
+        "  --list                 List the available scenarios and exit\n";
+
+    struct CommandLine
+    {
+        game::GameConfiguration config;
+        Options options;
+        std::size_t iterations = 3;
+        std::string outputFile;
+        std::vector<std::string> scenarios;
+        bool listScenarios = false;
+    };
+
+    struct ScenarioResult
+    {
+        std::string name;
+        std::vector<double> milliseconds;
+        std::size_t numAllocations = 0;
+        std::size_t allocatedBytes = 0;
+        std::size_t peakResidentBytes = 0;
+    };
+
+    CommandLine parseCommandLine(int argc, char* argv[])
+    {
+        CommandLine commandLine;
+        commandLine.config.gameType = "Doom 3";
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+
+            if (arg == "--list")
+            {
+                commandLine.listScenarios = true;
+                continue;
+            }
+
+            if (arg.compare(0, 2, "--") != 0)
+            {
+                commandLine.scenarios.push_back(arg);
+                continue;
+            }
+
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+
+            std::string value = argv[++i];
+
+            if (arg == "--game")
+            {
+                commandLine.config.gameType = value;
+            }
+            else if (arg == "--engine-path")
+            {
+                commandLine.config.enginePath = os::standardPathWithSlash(value);
+            }
+            else if (arg == "--mod-base")
+            {
+                commandLine.config.modBasePath = os::standardPathWithSlash(value);
+            }
+            else if (arg == "--mod")
+            {
+                commandLine.config.modPath = os::standardPathWithSlash(value);
+            }
+            else if (arg == "--map")
+            {
+                commandLine.options.mapPath = value;
+            }
+            else if (arg == "--prefab")
+            {
+                commandLine.options.prefabPath = value;
+            }
+            else if (arg == "--iterations")
+            {
+                commandLine.iterations = std::max(string::convert<std::size_t>(value), std::size_t(1));
+            }
+            else if (arg == "--output")
+            {
+                commandLine.outputFile = value;
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+
+        return commandLine;
+    }
+
+    std::string escapeJson(const std::string& input)
+    {
+        std::string output;
+        output.reserve(input.size());
+
+        for (char c : input)
+        {
+            switch (c)
+            {
+            case '"': output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n"; break;
+            case '\t': output += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    output += buffer;
+                }
+                else
+                {
+                    output += c;
+                }
+            }
+        }
+
+        return output;
+    }
+
+    std::string writeReport(const CommandLine& commandLine, double startupMilliseconds,
+        const std::vector<ScenarioResult>& results)
+    {
+        std::ostringstream json;
+
+        json << "{\n";
+        json << "  \"version\": \"" << escapeJson(RADIANT_VERSION) << "\",\n";
+        json << "  \"game\": \"" << escapeJson(commandLine.config.gameType) << "\",\n";
+        json << "  \"map\": \"" << escapeJson(commandLine.options.mapPath) << "\",\n";
+        json << "  \"iterations\": " << commandLine.iterations << ",\n";
+        json << "  \"startupMilliseconds\": " << startupMilliseconds << ",\n";
+        json << "  \"scenarios\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& result = results[i];
+
+            auto sorted = result.milliseconds;
+            std::sort(sorted.begin(), sorted.end());
+
+            double total = 0;
+            for (auto msecs : sorted) total += msecs;
+
+            json << (i > 0 ? ",\n" : "\n");
+            json << "    {\n";
+            json << "      \"name\": \"" << escapeJson(result.name) << "\",\n";
+            json << "      \"milliseconds\": [";
+
+            for (std::size_t j = 0; j < result.milliseconds.size(); ++j)
+            {
+                json << (j > 0 ? ", " : "") << result.milliseconds[j];
+            }
+
+            json << "],\n";
+            json << "      \"minMilliseconds\": " << sorted.front() << ",\n";
+            json << "      \"medianMilliseconds\": " << sorted[sorted.size() / 2] << ",\n";
+            json << "      \"meanMilliseconds\": " << total / sorted.size() << ",\n";
+            json << "      \"allocationsPerIteration\": " << result.numAllocations / sorted.size() << ",\n";
+            json << "      \"allocatedBytesPerIteration\": " << result.allocatedBytes / sorted.size() << ",\n";
+            json << "      \"peakResidentBytes\": " << result.peakResidentBytes << "\n";
+            json << "    }";
+        }
+
+        json << "\n  ]\n}\n";
+
+        return json.str();
+    }
+
+    ScenarioResult runScenario(const Scenario& scenario, std::size_t iterations)
+    {
+        ScenarioResult result;
+        result.name = scenario.name;
+
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            if (scenario.prepare) scenario.prepare();
+
+            auto before = MemoryStatistics::Sample();
+            util::StopWatch stopWatch;
+
+            scenario.run();
+
+            auto microseconds = stopWatch.getMicroSecondsPassed();
+            auto after = MemoryStatistics::Sample();
+
+            result.milliseconds.push_back(microseconds / 1000.0);
+            result.numAllocations += after.numAllocations - before.numAllocations;
+            result.allocatedBytes += after.allocatedBytes - before.allocatedBytes;
+            result.peakResidentBytes = after.peakResidentBytes;
+
+            if (scenario.cleanup) scenario.cleanup();
+        }
+
+        return result;
+    }
+
+    int run(int argc, char* argv[])
+    {
+        auto commandLine = parseCommandLine(argc, argv);
+
+        auto settingsPath = (fs::temp_directory_path() / "worldedit-benchmark").string();
+        commandLine.options.outputPath = settingsPath;
+
+        auto scenarios = createScenarios(commandLine.options);
+
+        if (commandLine.listScenarios)
+        {
+            for (const auto& scenario : scenarios)
+            {
+                std::cout << scenario.name << "\t" << scenario.description << std::endl;
+            }
+            return 0;
+        }
+
+        // Pick the requested scenarios, or all which can run with the given arguments
+        std::vector<Scenario> selected;
+
+        if (commandLine.scenarios.empty())
+        {
+            std::copy_if(scenarios.begin(), scenarios.end(), std::back_inserter(selected),
+                [&](const Scenario& s) { return !s.needsMap || !commandLine.options.mapPath.empty(); });
+        }
+
+        for (const auto& name : commandLine.scenarios)
+        {
+            auto found = std::find_if(scenarios.begin(), scenarios.end(),
+                [&](const Scenario& s) { return s.name == name; });
+
+            if (found == scenarios.end())
+            {
+                throw std::invalid_argument("Unknown scenario " + name);
+            }
+
+            if (found->needsMap && commandLine.options.mapPath.empty())
+            {
+                throw std::invalid_argument("Scenario " + name + " needs a map to be passed with --map");
+            }
+
+            selected.push_back(*found);
+        }
+
+        if (commandLine.config.enginePath.empty())
+        {
+            throw std::invalid_argument("No engine path given");
+        }
+
+        // Start with empty settings on every run, the core is not passed
+        // any of the benchmark's arguments
+        fs::remove_all(settingsPath);
+        fs::create_directories(settingsPath);
+
+        BenchmarkContext context;
+        context.setSettingsPath(settingsPath);
+        context.initialise(1, argv);
+
+        util::StopWatch startupTimer;
+
+        auto coreModule = std::make_unique<module::CoreModule>(context);
+        auto* radiant = coreModule->get();
+
+        module::RegistryReference::Instance().setRegistry(radiant->getModuleRegistry());
+        module::initialiseStreams(radiant->getLogWriter());
+
+        // Parsing floats from text files needs the C locale
+        setlocale(LC_NUMERIC, "C");
+
+        // The settings are empty, so the game manager is always asking for a configuration
+        radiant->getMessageBus().addListener(radiant::IMessage::Type::GameConfigNeeded,
+            radiant::TypeListener<game::ConfigurationNeeded>([&](game::ConfigurationNeeded& message)
+        {
+            message.setConfig(commandLine.config);
+            message.setHandled(true);
+        }));
+
+        radiant->startup();
+
+        auto startupMilliseconds = startupTimer.getMicroSecondsPassed() / 1000.0;
+
+        std::vector<ScenarioResult> results;
+
+        for (const auto& scenario : selected)
+        {
+            // Scenarios working on the map need it to be loaded beforehand
+            if (scenario.needsMap && scenario.name != "load-map" && GlobalMapModule().isUnnamed())
+            {
+                loadMap(commandLine.options.mapPath);
+            }
+
+            std::fprintf(stderr, "Running %s...\n", scenario.name.c_str());
+            results.emplace_back(runScenario(scenario, commandLine.iterations));
+        }
+
+        auto report = writeReport(commandLine, startupMilliseconds, results);
+
+        module::GlobalModuleRegistry().shutdownModules();
+        coreModule.reset();
+
+        // std::cout might be redirected to the log while the core is running
+        if (commandLine.outputFile.empty())
+        {
+            std::fputs(report.c_str(), stdout);
+        }
+        else
+        {
+            std::ofstream output(commandLine.outputFile);
+            output << report;
+        }
+
+        return 0;
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return benchmark::run(argc, argv);
+    }
+    catch (const std::exception& ex)
+    {
+        std::fprintf(stderr, "%s\n\n%s", ex.what(), benchmark::USAGE);
+        return 1;
+    }
+}
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "inode.h"
-#include <string>
+#include "math/FastHash.h"
 
 namespace scene
 {
 
+// Fingerprints are 128 bit hashes, usable as keys in ordered and unordered containers
+using Fingerprint = math::Hash128;
+
 /**
  * Prototype of a comparable scene node, providing hash information
  * for comparison to another node. Nodes of the same type can be compared against each other.
@@ -19,7 +22,8 @@ public:
     // Returns the fingerprint (checksum) of this node, to allow for quick 
     // matching against other nodes of the same type. Fingerprints of different
     // types are not comparable, be sure to check the node type first.
-    virtual std::string getFingerprint() = 0;
+    // Calculating fingerprints of different nodes concurrently is allowed.
+    virtual Fingerprint getFingerprint() = 0;
 };
 
 // The number of digits that are considered when hashing floating point values in fingerprinting
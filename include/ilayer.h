@@ -1,6 +1,10 @@
 #pragma once
 
 #include <set>
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <initializer_list>
 #include <string>
 #include <functional>
 #include "imodule.h"
@@ -12,8 +16,216 @@ namespace scene
 class INode;
 typedef std::shared_ptr<INode> INodePtr;
 
-// A list of named layers
-typedef std::set<int> LayerList;
+/**
+ * A set of layer IDs, as assigned to a Layered object.
+ *
+ * Offers the subset of the std::set<int> interface needed by client code.
+ * IDs in the range [0..63] (which covers nearly all maps) are stored in a
+ * single bitmask, such that membership tests and checking two lists for
+ * common layers are simple bit operations. Any other IDs are stored in an
+ * ordinary set. Iteration yields the IDs of the bitmask in ascending order,
+ * followed by the overflowing IDs.
+ */
+class LayerList
+{
+public:
+	// Layer IDs below this value are stored in the bitmask
+	static constexpr int NumMaskBits = 64;
+
+private:
+	std::uint64_t _mask;
+	std::set<int> _overflow;
+
+public:
+	class const_iterator
+	{
+	private:
+		const LayerList* _list;
+
+		// The current bit, equals NumMaskBits once iteration reached the overflow set
+		int _bit;
+		std::set<int>::const_iterator _overflowIter;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = int;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const int*;
+		using reference = int;
+
+		const_iterator(const LayerList* list, int bit, std::set<int>::const_iterator overflowIter) :
+			_list(list),
+			_bit(bit),
+			_overflowIter(overflowIter)
+		{
+			skipUnsetBits();
+		}
+
+		int operator*() const
+		{
+			return _bit < NumMaskBits ? _bit : *_overflowIter;
+		}
+
+		const_iterator& operator++()
+		{
+			if (_bit < NumMaskBits)
+			{
+				++_bit;
+				skipUnsetBits();
+			}
+			else
+			{
+				++_overflowIter;
+			}
+
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			auto previous = *this;
+			++(*this);
+			return previous;
+		}
+
+		bool operator==(const const_iterator& other) const
+		{
+			return _bit == other._bit && _overflowIter == other._overflowIter;
+		}
+
+		bool operator!=(const const_iterator& other) const
+		{
+			return !operator==(other);
+		}
+
+	private:
+		void skipUnsetBits()
+		{
+			while (_bit < NumMaskBits && (_list->_mask & (std::uint64_t(1) << _bit)) == 0)
+			{
+				// Jump to the end of the bitmask if no higher bits are set
+				_bit = (_list->_mask >> _bit) == 0 ? NumMaskBits : _bit + 1;
+			}
+		}
+	};
+
+	using iterator = const_iterator;
+
+	LayerList() :
+		_mask(0)
+	{}
+
+	LayerList(std::initializer_list<int> layerIds) :
+		LayerList()
+	{
+		insert(layerIds.begin(), layerIds.end());
+	}
+
+	// Adds the given ID, returns true if it hasn't been part of this list before
+	bool insert(int layerId)
+	{
+		if (!isMaskable(layerId))
+		{
+			return _overflow.insert(layerId).second;
+		}
+
+		auto bit = std::uint64_t(1) << layerId;
+		auto inserted = (_mask & bit) == 0;
+		_mask |= bit;
+
+		return inserted;
+	}
+
+	template<typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			insert(*first);
+		}
+	}
+
+	// Removes the given ID, returns the number of removed elements (0 or 1)
+	std::size_t erase(int layerId)
+	{
+		if (!isMaskable(layerId))
+		{
+			return _overflow.erase(layerId);
+		}
+
+		auto erased = count(layerId);
+		_mask &= ~(std::uint64_t(1) << layerId);
+
+		return erased;
+	}
+
+	std::size_t count(int layerId) const
+	{
+		if (!isMaskable(layerId))
+		{
+			return _overflow.count(layerId);
+		}
+
+		return (_mask >> layerId) & 1;
+	}
+
+	void clear()
+	{
+		_mask = 0;
+		_overflow.clear();
+	}
+
+	bool empty() const
+	{
+		return _mask == 0 && _overflow.empty();
+	}
+
+	std::size_t size() const
+	{
+		return std::bitset<NumMaskBits>(_mask).count() + _overflow.size();
+	}
+
+	// Returns true if the two lists have at least one ID in common
+	bool intersects(const LayerList& other) const
+	{
+		if ((_mask & other._mask) != 0) return true;
+
+		if (_overflow.empty() || other._overflow.empty()) return false;
+
+		for (auto layerId : _overflow)
+		{
+			if (other._overflow.count(layerId) > 0) return true;
+		}
+
+		return false;
+	}
+
+	bool operator==(const LayerList& other) const
+	{
+		return _mask == other._mask && _overflow == other._overflow;
+	}
+
+	bool operator!=(const LayerList& other) const
+	{
+		return !operator==(other);
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, 0, _overflow.begin());
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, NumMaskBits, _overflow.end());
+	}
+
+private:
+	static bool isMaskable(int layerId)
+	{
+		return layerId >= 0 && layerId < NumMaskBits;
+	}
+};
 
 /**
  * greebo: Interface of a Layered object.
@@ -36,6 +36,10 @@ namespace map
  * is calling the same instance of this PrimitiveParser over and over, one call for each
  * primitive, so when returning from the parse() method the class should be ready
  * to process the next primitive.
+ *
+ * The Doom 3 map readers call parse() concurrently from several worker threads,
+ * the created nodes are not part of any scene at that point. Parsers must not
+ * access global state that isn't safe to use from worker threads.
  */
 class PrimitiveParser
 {
@@ -120,6 +124,23 @@ public:
 	// Patch export methods
 	virtual void beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream) = 0;
 	virtual void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) = 0;
+
+	/**
+	 * Allows the map saving algorithm to write parts of the map on worker threads.
+	 *
+	 * Returns a new writer which produces the same text this writer would after
+	 * entityCount calls to beginWriteEntity() and primitiveCount primitives
+	 * written since the last call to endWriteEntity(). The returned writer is
+	 * used on a single worker thread, the text is written to the map in order.
+	 *
+	 * Writers whose output depends on anything else than these counters, or which
+	 * need to access non-thread-safe modules, return an empty pointer (the default).
+	 * All nodes are then written on the calling thread.
+	 */
+	virtual std::shared_ptr<IMapWriter> createConcurrentWriter(std::size_t entityCount, std::size_t primitiveCount)
+	{
+		return std::shared_ptr<IMapWriter>();
+	}
 };
 typedef std::shared_ptr<IMapWriter> IMapWriterPtr;
 
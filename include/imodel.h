@@ -190,6 +190,20 @@ public:
 	* an empty IModelPtr if the model loader could not load the file.
 	*/
 	virtual model::IModelPtr loadModelFromPath(const std::string& path) = 0;
+
+	/**
+	* Like loadModelFromPath(), but safe to call from a worker thread, other modules
+	* like the game settings or the material manager are not queried. The returned
+	* model needs to be passed to finishModelLoad() on the main thread before use.
+	*/
+	virtual model::IModelPtr parseModelFromPath(const std::string& path)
+	{
+		return loadModelFromPath(path);
+	}
+
+	// Resolves the parts of a model returned by parseModelFromPath() which depend on other modules
+	virtual void finishModelLoad(const model::IModelPtr& model)
+	{}
 };
 typedef std::shared_ptr<IModelImporter> IModelImporterPtr;
 
@@ -4,10 +4,14 @@
 #include "imodel.h"
 #include "inode.h"
 #include <sigc++/signal.h>
+#include <sigc++/slot.h>
 
 namespace model 
 {
 
+// Receives the model node which has been loaded in the background
+using ModelNodeCallback = sigc::slot<void(const scene::INodePtr&)>;
+
 /** Modelcache interface.
  */
 class IModelCache :
@@ -28,6 +32,40 @@ public:
 	 */
 	virtual scene::INodePtr getModelNode(const std::string& modelPath) = 0;
 
+	/**
+	 * Like getModelNode(), but the model file is parsed on a worker thread.
+	 * If the model is not cached yet, a placeholder NullModel node is returned
+	 * right away. The callback is invoked with the actual node as soon as it
+	 * is ready, from within processLoadedModels() on the main thread.
+	 * Concurrent requests for the same path share a single load.
+	 *
+	 * If the returned node is the final one, the callback is never invoked.
+	 */
+	virtual scene::INodePtr getModelNodeAsync(const std::string& modelPath, const ModelNodeCallback& callback) = 0;
+
+	/**
+	 * Like getModelNodeAsync(), without returning a node. The callback is always
+	 * invoked from within processLoadedModels(), even if the model is cached already.
+	 * Used to get the model for a placeholder node restored by an undo operation.
+	 */
+	virtual void requestModelNode(const std::string& modelPath, const ModelNodeCallback& callback) = 0;
+
+	// Returns true if the given model path is being loaded by getModelNodeAsync(),
+	// i.e. the node returned for it has been a placeholder.
+	virtual bool isModelPending(const std::string& modelPath) const = 0;
+
+	/**
+	 * Hands the models parsed in the background since the last call to their
+	 * requesters. Must be called regularly from the main thread.
+	 *
+	 * @returns: true if any model nodes have been delivered.
+	 */
+	virtual bool processLoadedModels() = 0;
+
+	// Returns the number of model paths which are still being loaded in the
+	// background, or have been loaded but not handed out by processLoadedModels().
+	virtual std::size_t getNumPendingModels() const = 0;
+
 	/**
 	 * greebo: Get the IModel object for the given VFS path. The request is cached,
 	 * so calling this with the same path twice will return the same
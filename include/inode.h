@@ -57,6 +57,22 @@ typedef std::shared_ptr<IMapRootNode> IMapRootNodePtr;
 class Graph;
 typedef std::shared_ptr<Graph> GraphPtr;
 
+/**
+ * Book-keeping data owned by the space partition system a node is linked to.
+ * It enables the space partition to locate the node in constant time
+ * when unlinking it, without maintaining a separate lookup table.
+ * Nothing but the owning ISpacePartitionSystem should ever touch this.
+ */
+struct SpacePartitionSlot
+{
+	// The space partition this node is linked to (nullptr if not linked)
+	const void* owner = nullptr;
+
+	// Implementation-defined location of the node within the owner
+	std::size_t cell = 0;
+	std::size_t index = 0;
+};
+
 class NodeVisitor
 {
 public:
@@ -277,6 +293,9 @@ public:
 	// Method invoked on every node whenever the filter system
 	// changes its state - nodes get a chance to react on that
 	virtual void onFiltersChanged() = 0;
+
+	// Slot reserved for the space partition system this node is linked into
+	virtual SpacePartitionSlot& getSpacePartitionSlot() = 0;
 };
 
 /// Cast an INode to a particular interface
@@ -65,6 +65,10 @@ public:
 	// Retrieves the nodelist corresponding for the specified XPath (wraps to xml::Document)
 	virtual xml::NodeList findXPath(const std::string& path) = 0;
 
+	// Like findXPath(), for callers which are only going to read the returned nodes.
+	// Doesn't drop any cached key values, unlike findXPath().
+	virtual xml::NodeList findXPathReadOnly(const std::string& path) const = 0;
+
 	// Creates an empty key
 	virtual xml::Node createKey(const std::string& key) = 0;
 
@@ -537,6 +537,7 @@ public:
 };
 
 constexpr const char* const RKEY_ENABLE_SHADOW_MAPPING = "user/ui/renderSystem/enableShadowMapping";
+constexpr const char* const RKEY_PARALLEL_PREPARATION = "user/ui/renderSystem/parallelPreparation";
 
 /**
  * \brief
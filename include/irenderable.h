@@ -100,6 +100,16 @@ public:
      **/
     virtual void onPreRender(const VolumeTest& volume) = 0;
 
+    /**
+     * Optional part of the preparation phase which is limited to the state
+     * owned by this renderable (like evaluating tesselations), without touching
+     * shaders, the scenegraph or any other module. The front-end may call this
+     * for many renderables in parallel, right before calling onPreRender()
+     * on each of them sequentially. onPreRender() must not rely on it.
+     */
+    virtual void onPreRenderLocal(const VolumeTest& volume)
+    {}
+
     // Submit renderable geometry for highlighting the object
     virtual void renderHighlights(IRenderableCollector& collector, const VolumeTest& volume) = 0;
 
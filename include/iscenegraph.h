@@ -84,6 +84,22 @@ public:
 	// A specific node has changed its bounds
 	virtual void nodeBoundsChanged(const scene::INodePtr& node) = 0;
 
+	/**
+	 * Counters of the space partition maintenance caused by bounds changes.
+	 * The values are accumulated over the lifetime of the graph, clients
+	 * can take the difference of two samples to get the numbers of a period.
+	 */
+	struct BoundsUpdateStatistics
+	{
+		// Number of nodeBoundsChanged() notifications received
+		std::size_t boundsChanges = 0;
+
+		// Number of unlink/link pairs performed in the space partition
+		std::size_t relinks = 0;
+	};
+
+	virtual BoundsUpdateStatistics getBoundsUpdateStatistics() const = 0;
+
 	// A walker class to be used in "foreachNodeInVolume"
 	class Walker
 	{
@@ -609,6 +609,15 @@ public:
 
 	// Reload the textures used by the active shaders
 	virtual void reloadImages() = 0;
+
+	// Uploads the textures whose images have been loaded in the background
+	// since the last call. Called by the render system at the start of
+	// each frame, with the GL context being current.
+	virtual void uploadPendingTextures() = 0;
+
+	// Returns true if background-loaded textures are waiting for their upload.
+	// The UI keeps requesting frames while this is the case.
+	virtual bool hasPendingTextureUploads() = 0;
 };
 
 inline IMaterialManager& GlobalMaterialManager()
@@ -3,10 +3,12 @@
 
 #include <list>
 #include <vector>
+#include <functional>
 #include "imodule.h"
 
 // Forward declaration
 class AABB;
+class VolumeTest;
 
 namespace scene
 {
@@ -75,12 +77,20 @@ typedef std::shared_ptr<ISPNode> ISPNodePtr;
  * Note: It's not allowed to call link() for nodes which are already linked into the tree.
  * It's safe to call unlink() for any node at any time, even multiple times in a row.
  * The unlink() method will return true if the node had been linked before.
+ *
+ * The foreachMemberInVolume() method is the fast path used by the scenegraph
+ * to cull the scene, implementations are free to traverse their internal
+ * structures directly, without going through the ISPNode hierarchy.
  */
 class ISpacePartitionSystem
 {
 public:
 	virtual ~ISpacePartitionSystem() {}
 
+	// Visitor function used when traversing the members of the SP tree,
+	// return false to stop the traversal
+	typedef std::function<bool(const scene::INodePtr&)> MemberVisitor;
+
 	// Links this node into the SP tree. Returns the node it ends up being associated with
 	virtual void link(const scene::INodePtr& sceneNode) = 0;
 
@@ -90,6 +100,11 @@ public:
 
 	// Returns the root node of this SP tree (the largest one, encompassing everything)
 	virtual ISPNodePtr getRoot() const = 0;
+
+	// Invokes the visitor for each member of each SP node (partially) intersecting
+	// the given volume. The members of the root node are always visited.
+	// Returns false if the visitor requested to stop the traversal.
+	virtual bool foreachMemberInVolume(const VolumeTest& volume, const MemberVisitor& visitor) = 0;
 };
 typedef std::shared_ptr<ISpacePartitionSystem> ISpacePartitionSystemPtr;
 
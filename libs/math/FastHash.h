@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include "Hash.h"
+#include "Vector3.h"
+
+namespace math
+{
+
+// A 128 bit hash value as calculated by FastHash, all zeros is considered empty
+struct Hash128
+{
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+    bool empty() const
+    {
+        return low == 0 && high == 0;
+    }
+
+    bool operator==(const Hash128& other) const
+    {
+        return low == other.low && high == other.high;
+    }
+
+    bool operator!=(const Hash128& other) const
+    {
+        return !operator==(other);
+    }
+
+    bool operator<(const Hash128& other) const
+    {
+        return high < other.high || (high == other.high && low < other.low);
+    }
+
+    // Returns the hash as string of 32 hex characters (an empty string if empty)
+    std::string toString() const
+    {
+        if (empty()) return std::string();
+
+        constexpr char hexChars[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+
+        std::string hexString(32, '\0');
+
+        for (auto i = 0; i < 16; ++i)
+        {
+            auto byte = static_cast<unsigned>(((i < 8 ? high : low) >> (56 - (i % 8) * 8)) & 0xFF);
+
+            hexString[i*2] = hexChars[(byte & 0xF0) >> 4];
+            hexString[i*2 + 1] = hexChars[byte & 0x0F];
+        }
+
+        return hexString;
+    }
+};
+
+/**
+ * Non-cryptographic 128 bit hash with the same interface as math::Hash,
+ * intended for fingerprinting large numbers of scene nodes. The input is
+ * consumed in 64 bit words by two differently seeded lanes using the round
+ * and avalanche functions of xxHash64. No heap allocations are involved.
+ */
+class FastHash
+{
+private:
+    static constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ULL;
+    static constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+    std::uint64_t _lane1;
+    std::uint64_t _lane2;
+    std::uint64_t _length;
+
+public:
+    FastHash() :
+        _lane1(Prime1 + Prime2),
+        _lane2(Prime5 - Prime1),
+        _length(0)
+    {}
+
+    void addSizet(std::size_t value)
+    {
+        addWord(static_cast<std::uint64_t>(value));
+    }
+
+    void addDouble(double value, std::size_t significantDigits)
+    {
+        addWord(static_cast<std::uint64_t>(
+            static_cast<std::int64_t>(value * detail::RoundingFactor(significantDigits))));
+    }
+
+    template<typename ElementType>
+    void addVector3(const BasicVector3<ElementType>& v, std::size_t significantDigits)
+    {
+        addDouble(v.x(), significantDigits);
+        addDouble(v.y(), significantDigits);
+        addDouble(v.z(), significantDigits);
+    }
+
+    void addString(const std::string& str)
+    {
+        auto data = str.data();
+        auto remaining = str.length();
+
+        for (; remaining >= 8; data += 8, remaining -= 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data, 8);
+            addWord(word);
+        }
+
+        // Pack the tail together with the length, this delimits subsequent strings
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, data, remaining);
+
+        addWord(tail);
+        addWord(static_cast<std::uint64_t>(str.length()));
+    }
+
+    void addHash(const Hash128& hash)
+    {
+        addWord(hash.low);
+        addWord(hash.high);
+    }
+
+    operator Hash128() const
+    {
+        Hash128 result;
+
+        result.low = avalanche(_lane1 + _length * Prime5 + rotateLeft(_lane2, 27));
+        result.high = avalanche(_lane2 ^ (_length * Prime4) ^ rotateLeft(_lane1, 33));
+
+        return result;
+    }
+
+private:
+    void addWord(std::uint64_t word)
+    {
+        _lane1 = round(_lane1, word);
+        _lane2 = round(_lane2, rotateLeft(word, 32) ^ Prime3);
+        _length += 8;
+    }
+
+    static std::uint64_t rotateLeft(std::uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static std::uint64_t round(std::uint64_t accumulator, std::uint64_t input)
+    {
+        accumulator += input * Prime2;
+        accumulator = rotateLeft(accumulator, 31);
+        return accumulator * Prime1;
+    }
+
+    static std::uint64_t avalanche(std::uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+};
+
+}
+
+namespace std
+{
+
+template<>
+struct hash<math::Hash128>
+{
+    std::size_t operator()(const math::Hash128& hash) const noexcept
+    {
+        // The value is already well distributed
+        return static_cast<std::size_t>(hash.low);
+    }
+};
+
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#ifdef WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace os
+{
+
+/**
+ * Read-only memory mapping of a whole file. The mapped bytes stay valid
+ * as long as this object is alive, it can be shared between threads.
+ *
+ * The file must not be truncated while it is mapped, accessing the pages
+ * beyond the new end raises SIGBUS (or an access violation on Windows).
+ */
+class MappedFile
+{
+public:
+	typedef unsigned char byte_type;
+	typedef std::shared_ptr<MappedFile> Ptr;
+
+private:
+	const byte_type* _data;
+	std::size_t _size;
+
+#ifdef WIN32
+	HANDLE _file;
+	HANDLE _mapping;
+#endif
+
+	MappedFile() :
+		_data(nullptr),
+		_size(0)
+#ifdef WIN32
+		, _file(INVALID_HANDLE_VALUE)
+		, _mapping(nullptr)
+#endif
+	{}
+
+public:
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+
+	~MappedFile()
+	{
+#ifdef WIN32
+		if (_data != nullptr) UnmapViewOfFile(_data);
+		if (_mapping != nullptr) CloseHandle(_mapping);
+		if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+#else
+		if (_data != nullptr) munmap(const_cast<byte_type*>(_data), _size);
+#endif
+	}
+
+	/// Maps the file at the given path into memory. Returns an empty pointer
+	/// if the file cannot be opened or mapped, or if it is empty.
+	static Ptr open(const std::string& path)
+	{
+		Ptr mappedFile(new MappedFile);
+
+#ifdef WIN32
+		mappedFile->_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (mappedFile->_file == INVALID_HANDLE_VALUE) return Ptr();
+
+		LARGE_INTEGER size;
+
+		if (!GetFileSizeEx(mappedFile->_file, &size) || size.QuadPart == 0) return Ptr();
+
+		mappedFile->_mapping = CreateFileMappingA(mappedFile->_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (mappedFile->_mapping == nullptr) return Ptr();
+
+		auto view = MapViewOfFile(mappedFile->_mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (view == nullptr) return Ptr();
+
+		mappedFile->_data = static_cast<const byte_type*>(view);
+		mappedFile->_size = static_cast<std::size_t>(size.QuadPart);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+
+		if (fd == -1) return Ptr();
+
+		struct stat info;
+
+		if (fstat(fd, &info) != 0 || info.st_size == 0)
+		{
+			::close(fd);
+			return Ptr();
+		}
+
+		auto view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+		// The mapping stays valid after closing the descriptor
+		::close(fd);
+
+		if (view == MAP_FAILED) return Ptr();
+
+		mappedFile->_data = static_cast<const byte_type*>(view);
+		mappedFile->_size = static_cast<std::size_t>(info.st_size);
+#endif
+		return mappedFile;
+	}
+
+	const byte_type* data() const
+	{
+		return _data;
+	}
+
+	std::size_t size() const
+	{
+		return _size;
+	}
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "ParseException.h"
 
+#include <cstdlib>
 #include <iterator>
 #include <iostream>
 #include <ios>
@@ -422,6 +423,16 @@ public:
 	 * next without actually changing the tokeniser's state.
 	 */
 	virtual std::string peek() const = 0;
+
+	/**
+	 * Consume the next token and return its numeric value, using the same
+	 * conversion as std::atof() (non-numeric tokens evaluate to 0).
+	 * Subclasses can override this to avoid the temporary string.
+	 */
+	virtual double nextDouble()
+	{
+		return std::atof(nextToken().c_str());
+	}
 };
 
 /**
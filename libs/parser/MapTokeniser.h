@@ -0,0 +1,607 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <string>
+#include <string_view>
+#include "DefTokeniser.h"
+
+namespace parser
+{
+
+/**
+ * High-throughput DefTokeniser for large inputs like map files.
+ *
+ * The whole stream is read into memory in large blocks on construction,
+ * tokens are returned as views into that buffer. Only tokens which need
+ * to be assembled (quoted strings containing escape sequences or backslash
+ * continuations, tokens interrupted by comments) are copied into an internal
+ * scratch string. The tokenisation rules are exactly the same as the ones
+ * of the BasicDefTokeniser (see DefTokeniserFunc).
+ *
+ * nextDouble() parses plain decimal numbers without going through a string
+ * or the C library, all other number formats fall back to std::atof().
+ */
+class MapTokeniser :
+	public DefTokeniser
+{
+private:
+	static constexpr std::size_t READ_BLOCK_SIZE = 4 * 1024 * 1024;
+
+	enum CharClass : std::uint8_t
+	{
+		PLAIN = 0,
+		DELIM = 1,
+		KEPT_DELIM = 2,
+		QUOTE = 3,
+		SLASH = 4,
+	};
+
+	CharClass _charClass[256];
+
+	std::string _buffer;
+	const char* _cur;
+	const char* _end;
+
+	// Where parsing of the lookahead token started (including any leading comments)
+	const char* _tokenStart;
+
+	// The lookahead token
+	std::string_view _token;
+	bool _hasToken;
+
+	// Assembled tokens are stored here, alternating between the two buffers such
+	// that the lookahead token doesn't overwrite the token returned last
+	std::string _scratch[2];
+	std::size_t _scratchIndex;
+
+public:
+	/**
+	 * Construct a MapTokeniser reading the given input stream to its end.
+	 * Delimiters have the same meaning as in BasicDefTokeniser<std::istream>.
+	 */
+	MapTokeniser(std::istream& str,
+				 const char* delims = WHITESPACE,
+				 const char* keptDelims = "{}(),") :
+		_hasToken(false),
+		_scratchIndex(0)
+	{
+		initCharClasses(delims, keptDelims);
+
+		// Read everything in large blocks
+		auto* streamBuffer = str.rdbuf();
+
+		if (streamBuffer != nullptr)
+		{
+			std::size_t length = 0;
+
+			while (true)
+			{
+				_buffer.resize(length + READ_BLOCK_SIZE);
+
+				auto bytesRead = streamBuffer->sgetn(&_buffer[length], READ_BLOCK_SIZE);
+				length += static_cast<std::size_t>(bytesRead);
+
+				if (bytesRead < static_cast<std::streamsize>(READ_BLOCK_SIZE)) break;
+			}
+
+			_buffer.resize(length);
+		}
+
+		_cur = _buffer.data();
+		_end = _buffer.data() + _buffer.size();
+
+		advance();
+	}
+
+	// Construct a MapTokeniser on the given string contents
+	MapTokeniser(std::string contents,
+				 const char* delims = WHITESPACE,
+				 const char* keptDelims = "{}(),") :
+		_buffer(std::move(contents)),
+		_hasToken(false),
+		_scratchIndex(0)
+	{
+		initCharClasses(delims, keptDelims);
+
+		_cur = _buffer.data();
+		_end = _buffer.data() + _buffer.size();
+
+		advance();
+	}
+
+	// The buffer is referenced by the token views, no copying allowed
+	MapTokeniser(const MapTokeniser& other) = delete;
+	MapTokeniser& operator=(const MapTokeniser& other) = delete;
+
+	bool hasMoreTokens() const override
+	{
+		return _hasToken;
+	}
+
+	/**
+	 * Returns the next token, without copying it. The returned view is valid
+	 * until the next call to any of the token retrieval methods.
+	 */
+	std::string_view nextTokenView()
+	{
+		if (!_hasToken)
+		{
+			throw ParseException("DefTokeniser: no more tokens");
+		}
+
+		auto token = _token;
+		advance();
+
+		return token;
+	}
+
+	std::string nextToken() override
+	{
+		return std::string(nextTokenView());
+	}
+
+	std::string peek() const override
+	{
+		if (!_hasToken)
+		{
+			throw ParseException("DefTokeniser: no more tokens");
+		}
+
+		return std::string(_token);
+	}
+
+	void assertNextToken(const std::string& val) override
+	{
+		auto tok = nextTokenView();
+
+		if (tok != val)
+		{
+			throw ParseException("DefTokeniser: Assertion failed: Required \""
+				+ val + "\", found \"" + std::string(tok) + "\"");
+		}
+	}
+
+	void skipTokens(unsigned int n) override
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			nextTokenView();
+		}
+	}
+
+	/**
+	 * Returns the offset of the lookahead token within the tokenised contents,
+	 * or the size of the contents if there are no more tokens. Leading comments
+	 * are considered part of the token.
+	 */
+	std::size_t getTokenOffset() const
+	{
+		return _hasToken ? static_cast<std::size_t>(_tokenStart - _buffer.data()) : _buffer.size();
+	}
+
+	// Returns the complete contents this tokeniser is operating on
+	std::string_view getContents() const
+	{
+		return _buffer;
+	}
+
+	double nextDouble() override
+	{
+		auto tok = nextTokenView();
+
+		double value;
+
+		if (tryParsePlainDecimal(tok, value))
+		{
+			return value;
+		}
+
+		// Anything more exotic (exponents, nan, etc.) is left to the C library
+		return std::atof(std::string(tok).c_str());
+	}
+
+private:
+	void initCharClasses(const char* delims, const char* keptDelims)
+	{
+		for (auto& charClass : _charClass)
+		{
+			charClass = PLAIN;
+		}
+
+		_charClass[static_cast<unsigned char>('"')] = QUOTE;
+		_charClass[static_cast<unsigned char>('/')] = SLASH;
+
+		// Delimiters take precedence over everything else, like in DefTokeniserFunc
+		for (const char* c = keptDelims; *c != 0; ++c)
+		{
+			_charClass[static_cast<unsigned char>(*c)] = KEPT_DELIM;
+		}
+
+		for (const char* c = delims; *c != 0; ++c)
+		{
+			_charClass[static_cast<unsigned char>(*c)] = DELIM;
+		}
+	}
+
+	CharClass getClass(char c) const
+	{
+		return _charClass[static_cast<unsigned char>(c)];
+	}
+
+	// Parses the next token into the lookahead slot
+	void advance()
+	{
+		// Skip leading delimiters
+		while (_cur != _end && getClass(*_cur) == DELIM)
+		{
+			++_cur;
+		}
+
+		_tokenStart = _cur;
+
+		if (_cur == _end)
+		{
+			_hasToken = false;
+			return;
+		}
+
+		const char* tokenStart = _cur;
+
+		switch (getClass(*_cur))
+		{
+		case KEPT_DELIM:
+			_token = std::string_view(_cur++, 1);
+			_hasToken = true;
+			return;
+
+		case PLAIN:
+		{
+			// Unquoted run of regular characters, the most common case
+			const char* p = _cur;
+
+			while (p != _end && getClass(*p) == PLAIN)
+			{
+				++p;
+			}
+
+			// A slash might start a comment, let the full state machine deal with it
+			if (p != _end && getClass(*p) == SLASH)
+			{
+				break;
+			}
+
+			// Delimiters and quotes terminate the token
+			_token = std::string_view(_cur, p - _cur);
+			_cur = p;
+			_hasToken = true;
+			return;
+		}
+
+		case QUOTE:
+		{
+			// Quoted string without any escape sequences
+			const char* p = _cur + 1;
+
+			while (p != _end && *p != '"' && *p != '\\')
+			{
+				++p;
+			}
+
+			if (p == _end || *p != '"')
+			{
+				break;
+			}
+
+			// Check for a backslash continuation after the closing quote
+			const char* afterQuote = p + 1;
+
+			while (afterQuote != _end && getClass(*afterQuote) == DELIM)
+			{
+				++afterQuote;
+			}
+
+			if (afterQuote != _end && *afterQuote == '\\')
+			{
+				break;
+			}
+
+			_token = std::string_view(_cur + 1, p - _cur - 1);
+			_cur = afterQuote;
+			_hasToken = true;
+			return;
+		}
+
+		default:
+			break;
+		}
+
+		// Fall back to the general tokeniser, starting over at the beginning of the token
+		_cur = tokenStart;
+		_hasToken = assembleToken();
+	}
+
+	// Full tokeniser state machine, equivalent to DefTokeniserFunc::operator()
+	bool assembleToken()
+	{
+		enum {
+			SEARCHING,
+			TOKEN_STARTED,
+			QUOTED,
+			AFTER_CLOSING_QUOTE,
+			SEARCHING_FOR_QUOTE,
+			FORWARDSLASH,
+			COMMENT_EOL,
+			COMMENT_DELIM,
+			STAR
+		} state = SEARCHING;
+
+		_scratchIndex ^= 1;
+		std::string& tok = _scratch[_scratchIndex];
+		tok.clear();
+
+		auto finish = [&]()
+		{
+			_token = tok;
+			return true;
+		};
+
+		while (_cur != _end)
+		{
+			char c = *_cur;
+
+			switch (state)
+			{
+			case SEARCHING:
+				if (getClass(c) == DELIM)
+				{
+					++_cur;
+					continue;
+				}
+
+				if (getClass(c) == KEPT_DELIM)
+				{
+					tok = c;
+					++_cur;
+					return finish();
+				}
+
+				state = TOKEN_STARTED;
+				// fall through
+
+			case TOKEN_STARTED:
+				if (getClass(c) == DELIM || getClass(c) == KEPT_DELIM)
+				{
+					return finish();
+				}
+
+				if (c == '"')
+				{
+					if (!tok.empty())
+					{
+						return finish();
+					}
+
+					state = QUOTED;
+					++_cur;
+					continue;
+				}
+
+				if (c == '/')
+				{
+					state = FORWARDSLASH;
+					++_cur;
+					continue;
+				}
+
+				tok += c;
+				++_cur;
+				continue;
+
+			case QUOTED:
+				if (c == '"')
+				{
+					++_cur;
+					state = AFTER_CLOSING_QUOTE;
+					continue;
+				}
+
+				if (c == '\\')
+				{
+					++_cur;
+
+					if (_cur != _end)
+					{
+						switch (*_cur)
+						{
+						case 'n': tok += '\n'; break;
+						case 't': tok += '\t'; break;
+						case '"': tok += '"'; break;
+						default:
+							tok += '\\';
+							tok += *_cur;
+						}
+
+						++_cur;
+					}
+
+					continue;
+				}
+
+				tok += c;
+				++_cur;
+				continue;
+
+			case AFTER_CLOSING_QUOTE:
+				if (c == '\\')
+				{
+					++_cur;
+					state = SEARCHING_FOR_QUOTE;
+					continue;
+				}
+
+				if (getClass(c) == DELIM)
+				{
+					++_cur;
+					continue;
+				}
+
+				return finish();
+
+			case SEARCHING_FOR_QUOTE:
+				if (getClass(c) == DELIM)
+				{
+					++_cur;
+					continue;
+				}
+
+				if (c == '"')
+				{
+					++_cur;
+					state = QUOTED;
+					continue;
+				}
+
+				throw ParseException("Could not find opening double quote after backslash.");
+
+			case FORWARDSLASH:
+				if (c == '*')
+				{
+					state = COMMENT_DELIM;
+					++_cur;
+					continue;
+				}
+
+				if (c == '/')
+				{
+					state = COMMENT_EOL;
+					++_cur;
+					continue;
+				}
+
+				// Not a comment, add the slash and re-examine this character
+				state = TOKEN_STARTED;
+				tok += '/';
+				continue;
+
+			case COMMENT_DELIM:
+				if (c == '*')
+				{
+					state = STAR;
+				}
+
+				++_cur;
+				continue;
+
+			case COMMENT_EOL:
+				++_cur;
+
+				if (c == '\r' || c == '\n')
+				{
+					if (!tok.empty())
+					{
+						return finish();
+					}
+
+					state = SEARCHING;
+				}
+
+				continue;
+
+			case STAR:
+				++_cur;
+
+				if (c == '/')
+				{
+					if (!tok.empty())
+					{
+						return finish();
+					}
+
+					state = SEARCHING;
+				}
+				else if (c != '*')
+				{
+					state = COMMENT_DELIM;
+				}
+
+				continue;
+			}
+		}
+
+		// Even an empty string is a valid token if it has been quoted
+		if (!tok.empty() || state == AFTER_CLOSING_QUOTE)
+		{
+			return finish();
+		}
+
+		return false;
+	}
+
+	// Parses numbers of the form [+-]digits[.digits]. Only succeeds if the result
+	// can be calculated exactly from an integer mantissa and a power of ten, in which
+	// case it's the same value std::atof() would return.
+	static bool tryParsePlainDecimal(std::string_view tok, double& value)
+	{
+		static constexpr double POWERS_OF_TEN[] =
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		// Integers up to 2^53 can be represented exactly
+		constexpr std::uint64_t MAX_EXACT_MANTISSA = std::uint64_t(1) << 53;
+
+		const char* p = tok.data();
+		const char* end = p + tok.size();
+
+		bool negative = false;
+
+		if (p != end && (*p == '-' || *p == '+'))
+		{
+			negative = *p == '-';
+			++p;
+		}
+
+		std::uint64_t mantissa = 0;
+		std::size_t numDigits = 0;
+		std::size_t numFractionDigits = 0;
+		bool inFraction = false;
+
+		for (; p != end; ++p)
+		{
+			if (*p >= '0' && *p <= '9')
+			{
+				mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+
+				if (mantissa > MAX_EXACT_MANTISSA) return false;
+
+				++numDigits;
+
+				if (inFraction) ++numFractionDigits;
+			}
+			else if (*p == '.' && !inFraction)
+			{
+				inFraction = true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		if (numDigits == 0 || numFractionDigits >= sizeof(POWERS_OF_TEN) / sizeof(double))
+		{
+			return false;
+		}
+
+		value = static_cast<double>(mantissa) / POWERS_OF_TEN[numFractionDigits];
+
+		if (negative) value = -value;
+
+		return true;
+	}
+};
+
+} // namespace parser
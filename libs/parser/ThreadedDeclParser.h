@@ -92,24 +92,42 @@ protected:
             return a.name < b.name;
         });
 
-        // Dispatch the sorted list to the protected parse() method
-        for (const auto& fileInfo : _incomingFiles)
+        parseFiles(_incomingFiles);
+    }
+
+    // Processes the given sorted file list. The default implementation dispatches
+    // each file to the protected parse() method, one after the other.
+    // Subclasses can override this to distribute the work over several threads.
+    virtual void parseFiles(const std::vector<vfs::FileInfo>& files)
+    {
+        for (const auto& fileInfo : files)
         {
-            auto file = GlobalFileSystem().openTextFile(fileInfo.fullPath());
+            parseFile(fileInfo, [this](std::istream& stream, const vfs::FileInfo& info, const std::string& modDir)
+            {
+                parse(stream, info, modDir);
+            });
+        }
+    }
+
+    // Opens the given file and passes its stream to the given parse function,
+    // signature is parseFunc(std::istream&, const vfs::FileInfo&, const std::string& modDir)
+    template<typename ParseFunc>
+    void parseFile(const vfs::FileInfo& fileInfo, const ParseFunc& parseFunc)
+    {
+        auto file = GlobalFileSystem().openTextFile(fileInfo.fullPath());
 
-            if (!file) continue;
+        if (!file) return;
 
-            try
-            {
-                // Parse entity defs from the file
-                std::istream stream(&file->getInputStream());
-                parse(stream, fileInfo, file->getModName());
-            }
-            catch (ParseException& e)
-            {
-                rError() << "[DeclParser] Failed to parse " << fileInfo.fullPath()
-                    << " (" << e.what() << ")" << std::endl;
-            }
+        try
+        {
+            // Parse entity defs from the file
+            std::istream stream(&file->getInputStream());
+            parseFunc(stream, fileInfo, file->getModName());
+        }
+        catch (ParseException& e)
+        {
+            rError() << "[DeclParser] Failed to parse " << fileInfo.fullPath()
+                << " (" << e.what() << ")" << std::endl;
         }
     }
 };
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cmath>
+#include "NopVolumeTest.h"
+#include "math/AABB.h"
+
+namespace render
+{
+
+/**
+ * VolumeTest implementation representing an axis-aligned box in world space.
+ * Useful to query the scenegraph's space partition for anything intersecting
+ * a given region, e.g. using GlobalSceneGraph().foreachNodeInVolume().
+ * The plane tests are not meaningful for this volume and always return true.
+ */
+class AABBVolumeTest :
+	public NopVolumeTest
+{
+private:
+	AABB _bounds;
+
+public:
+	AABBVolumeTest(const AABB& bounds) :
+		_bounds(bounds)
+	{}
+
+	const AABB& getBounds() const
+	{
+		return _bounds;
+	}
+
+	bool TestPoint(const Vector3& point) const override
+	{
+		return _bounds.intersects(point);
+	}
+
+	// Boxes merely touching the bounds are considered partially inside,
+	// since inclusive tests like the select-touching policy need to see them
+	VolumeIntersectionValue TestAABB(const AABB& aabb) const override
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			if (std::abs(aabb.origin[i] - _bounds.origin[i]) > aabb.extents[i] + _bounds.extents[i])
+			{
+				return VOLUME_OUTSIDE;
+			}
+		}
+
+		return _bounds.contains(aabb) ? VOLUME_INSIDE : VOLUME_PARTIAL;
+	}
+
+	VolumeIntersectionValue TestAABB(const AABB& aabb, const Matrix4& localToWorld) const override
+	{
+		return TestAABB(AABB::createFromOrientedAABBSafe(aabb, localToWorld));
+	}
+};
+
+} // namespace render
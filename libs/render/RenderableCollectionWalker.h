@@ -1,7 +1,11 @@
 #pragma once
 
+#include <vector>
 #include "iscenegraph.h"
+#include "irender.h"
+#include "registry/registry.h"
 #include "render/RenderableCollectorBase.h"
+#include "util/Parallel.h"
 
 namespace render
 {
@@ -13,20 +17,64 @@ namespace render
  */
 class RenderableCollectionWalker
 {
+private:
+	// Views with fewer visible nodes per thread are not worth the threading overhead
+	static constexpr std::size_t MIN_NODES_PER_THREAD = 256;
+
+	// More chunks than threads, such that nodes expensive to prepare even out
+	static constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
 public:
 	/**
 	 * \brief
 	 * Use a RenderableCollectionWalker to find all renderables in the global
 	 * scenegraph.
+	 *
+	 * If parallel preparation is enabled in the registry, the visible nodes are
+	 * gathered first and their onPreRenderLocal() part is run on worker threads.
+	 * The onPreRender() calls and the collection itself stay on the calling thread.
 	 */
 	static void CollectRenderablesInScene(RenderableCollectorBase& collector, const VolumeTest& volume)
 	{
-		// Submit renderables from scene graph
-		GlobalSceneGraph().foreachVisibleNodeInVolume(volume, [&](const scene::INodePtr& node)
+		if (!registry::getValue<bool>(RKEY_PARALLEL_PREPARATION))
 		{
-			collector.processNode(node, volume);
-			return true;
-		});
+			// Submit renderables from scene graph
+			GlobalSceneGraph().foreachVisibleNodeInVolume(volume, [&](const scene::INodePtr& node)
+			{
+				collector.processNode(node, volume);
+				return true;
+			});
+		}
+		else
+		{
+			std::vector<scene::INodePtr> nodes;
+
+			GlobalSceneGraph().foreachVisibleNodeInVolume(volume, [&](const scene::INodePtr& node)
+			{
+				nodes.push_back(node);
+				return true;
+			});
+
+			auto numThreads = util::getParallelThreadCount(nodes.size(), MIN_NODES_PER_THREAD);
+
+			if (numThreads > 1)
+			{
+				util::processChunksInParallel(nodes.size(), numThreads * CHUNKS_PER_THREAD, numThreads,
+					[&](std::size_t, std::size_t begin, std::size_t end)
+				{
+					for (auto i = begin; i < end; ++i)
+					{
+						nodes[i]->onPreRenderLocal(volume);
+					}
+				});
+			}
+
+			// Submit renderables in the same order as the scene graph walk
+			for (const auto& node : nodes)
+			{
+				collector.processNode(node, volume);
+			}
+		}
 
 		// Prepare any renderables that have been directly attached to the RenderSystem
 		// without belonging to an actual scene object
@@ -3,6 +3,7 @@
 #include "ieclass.h"
 #include "debugging/debugging.h"
 #include "string/predicate.h"
+#include <algorithm>
 #include <functional>
 
 Entity::Entity(const IEntityClassPtr& eclass) :
@@ -272,6 +273,7 @@ void Entity::insert(const std::string& key, const KeyValuePtr& keyValue)
 {
 	// Insert the new key at the end of the list
 	auto& pair = _keyValues.emplace_back(key, keyValue);
+	_keyAtoms.push_back(entity::SpawnargKeyPool::GetAtom(key));
 
 	// Dereference the iterator to get a KeyValue& reference and notify the observers
 	notifyInsert(key, *pair.second);
@@ -318,6 +320,7 @@ void Entity::erase(const KeyValues::iterator& i)
 	KeyValuePtr value(i->second);
 
 	// Actually delete the object from the list
+	_keyAtoms.erase(_keyAtoms.begin() + (i - _keyValues.begin()));
 	_keyValues.erase(i);
 
 	// Notify about the deletion
@@ -339,34 +342,25 @@ void Entity::erase(const std::string& key)
 	}
 }
 
-Entity::KeyValues::const_iterator Entity::find(const std::string& key) const
+std::size_t Entity::findIndex(const std::string& key) const
 {
-	for (KeyValues::const_iterator i = _keyValues.begin();
-		 i != _keyValues.end();
-		 ++i)
+	// A key which has never been assigned an atom can't be present on any entity
+	auto atom = entity::SpawnargKeyPool::FindAtom(key);
+
+	if (atom == entity::SpawnargKeyPool::NoAtom)
 	{
-		if (string::iequals(i->first, key))
-		{
-			return i;
-		}
+		return _keyAtoms.size();
 	}
 
-	// Not found
-	return _keyValues.end();
+	return std::find(_keyAtoms.begin(), _keyAtoms.end(), atom) - _keyAtoms.begin();
 }
 
-Entity::KeyValues::iterator Entity::find(const std::string& key)
+Entity::KeyValues::const_iterator Entity::find(const std::string& key) const
 {
-	for (KeyValues::iterator i = _keyValues.begin();
-		 i != _keyValues.end();
-		 ++i)
-	{
-		if (string::iequals(i->first, key))
-		{
-			return i;
-		}
-	}
+	return _keyValues.begin() + findIndex(key);
+}
 
-	// Not found
-	return _keyValues.end();
+Entity::KeyValues::iterator Entity::find(const std::string& key)
+{
+	return _keyValues.begin() + findIndex(key);
 }
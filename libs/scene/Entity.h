@@ -2,6 +2,7 @@
 
 #include "scene/AttachmentData.h"
 #include "scene/EntityKeyValue.h"
+#include "scene/SpawnargKeyPool.h"
 
 #include <vector>
 #include <memory>
@@ -63,6 +64,11 @@ private:
 	typedef std::vector<KeyValuePair> KeyValues;
 	KeyValues _keyValues;
 
+	// The pooled atoms of the keys, in the same order as _keyValues.
+	// Entities carry few keys, scanning this array is faster than
+	// comparing the key strings case-insensitively.
+	std::vector<entity::SpawnargKeyPool::Atom> _keyAtoms;
+
 	typedef std::set<Observer*> Observers;
 	Observers _observers;
 
@@ -242,6 +248,9 @@ private:
 	void erase(const KeyValues::iterator& i);
 	void erase(const std::string& key);
 
+	// Returns the index of the given key in _keyValues, or the size of the list if not present
+	std::size_t findIndex(const std::string& key) const;
+
 	KeyValues::iterator find(const std::string& key);
 	KeyValues::const_iterator find(const std::string& key) const;
 };
@@ -6,7 +6,7 @@
 #include "imodel.h"
 #include "imap.h"
 #include "itransformable.h"
-#include "math/Hash.h"
+#include "math/FastHash.h"
 #include "scenelib.h"
 #include "string/case_conv.h"
 
@@ -24,6 +24,7 @@ EntityNode::EntityNode(const IEntityClassPtr& eclass) :
 	_modelKey(*this),
 	_keyObservers(_spawnArgs),
 	_shaderParms(_keyObservers, _colourKey),
+	_changeTracker(*this),
 	_direction(1,0,0),
     _isAttachedToRenderSystem(false),
     _isShadowCasting(false)
@@ -47,6 +48,7 @@ EntityNode::EntityNode(const EntityNode& other) :
 	_modelKey(*this),
 	_keyObservers(_spawnArgs),
 	_shaderParms(_keyObservers, _colourKey),
+	_changeTracker(*this),
 	_direction(1,0,0),
     _isAttachedToRenderSystem(false),
     _isShadowCasting(false)
@@ -85,6 +87,8 @@ void EntityNode::construct()
 
 	_shaderParms.addKeyObservers();
 
+	_spawnArgs.attachObserver(&_changeTracker);
+
     // Construct all attached entities
     createAttachedEntities();
 }
@@ -126,6 +130,8 @@ void EntityNode::destruct()
 
 	_eclassChangedConn.disconnect();
 
+	_spawnArgs.detachObserver(&_changeTracker);
+
 	TargetableNode::destruct();
 }
 
@@ -249,7 +255,7 @@ bool EntityNode::isShadowCasting() const
     return _isShadowCasting;
 }
 
-std::string EntityNode::getFingerprint()
+scene::Fingerprint EntityNode::getFingerprint()
 {
     std::map<std::string, std::string> sortedKeyValues;
 
@@ -260,7 +266,7 @@ std::string EntityNode::getFingerprint()
         sortedKeyValues.emplace(string::to_lower_copy(key), string::to_lower_copy(value));
     }, false);
 
-    math::Hash hash;
+    math::FastHash hash;
 
     for (const auto& pair : sortedKeyValues)
     {
@@ -269,7 +275,7 @@ std::string EntityNode::getFingerprint()
     }
 
     // Entities need to include any child hashes, but be insensitive to their order
-    std::set<std::string> childFingerprints;
+    std::set<scene::Fingerprint> childFingerprints;
 
     foreachNode([&](const scene::INodePtr& child)
     {
@@ -283,9 +289,9 @@ std::string EntityNode::getFingerprint()
         return true;
     });
 
-    for (auto childFingerprint : childFingerprints)
+    for (const auto& childFingerprint : childFingerprints)
     {
-        hash.addString(childFingerprint);
+        hash.addHash(childFingerprint);
     }
 
     return hash;
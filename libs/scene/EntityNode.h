@@ -83,6 +83,36 @@ protected:
 	// Helper class observing the "shaderParmNN" spawnargs and caching their values
 	ShaderParms _shaderParms;
 
+	// Marks this node as changed whenever a spawnarg is inserted, changed or removed
+	class SpawnArgChangeTracker :
+		public Entity::Observer
+	{
+	private:
+		scene::Node& _node;
+
+	public:
+		SpawnArgChangeTracker(scene::Node& node) :
+			_node(node)
+		{}
+
+		void onKeyInsert(const std::string& key, EntityKeyValue& value) override
+		{
+			_node.markChanged();
+		}
+
+		void onKeyChange(const std::string& key, const std::string& value) override
+		{
+			_node.markChanged();
+		}
+
+		void onKeyErase(const std::string& key, EntityKeyValue& value) override
+		{
+			_node.markChanged();
+		}
+	};
+
+	SpawnArgChangeTracker _changeTracker;
+
 	// This entity's main direction, usually determined by the angle/rotation keys
 	Vector3 _direction;
 
@@ -161,7 +191,7 @@ public:
     }
 
     // IComparableNode implementation
-    std::string getFingerprint() override;
+    scene::Fingerprint getFingerprint() override;
 
 	// SelectionTestable implementation
 	virtual void testSelect(Selector& selector, SelectionTest& test) override;
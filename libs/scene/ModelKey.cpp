@@ -1,6 +1,7 @@
 #include "ModelKey.h"
 
 #include <functional>
+#include <sigc++/bind.h>
 
 #include "entitylib.h"
 #include "imodelcache.h"
@@ -11,6 +12,7 @@
 ModelKey::ModelKey(scene::INode& parentNode) :
 	_parentNode(parentNode),
 	_active(true),
+	_modelRequest(0),
 	_undo(_model, std::bind(&ModelKey::importState, this, std::placeholders::_1))
 {}
 
@@ -80,10 +82,17 @@ void ModelKey::attachModelNode()
         subscribeToModelDef(modelDef);
     }
 
-	// We have a non-empty model key, send the request to
-	// the model cache to acquire a new child node
-	_model.node = GlobalModelCache().getModelNode(actualModelPath);
+	// We have a non-empty model key, send the request to the model cache to
+	// acquire a new child node. Until the model file is parsed we get a placeholder.
+	_model.node = GlobalModelCache().getModelNodeAsync(actualModelPath, sigc::bind(
+		sigc::mem_fun(*this, &ModelKey::onModelLoaded), ++_modelRequest, _model.path));
+    _model.loading = GlobalModelCache().isModelPending(actualModelPath);
 
+    insertModelNode(modelDef);
+}
+
+void ModelKey::insertModelNode(const IModelDef::Ptr& modelDef)
+{
 	// The model loader should not return NULL, but a sanity check is always ok
     if (!_model.node) return;
 
@@ -118,10 +127,37 @@ void ModelKey::attachModelNode()
     _model.node->transformChanged();
 }
 
+void ModelKey::onModelLoaded(const scene::INodePtr& node, std::size_t modelRequest, const std::string& modelPath)
+{
+    // Ignore models which have been requested before the latest change or undo
+    if (!_active || modelRequest != _modelRequest || modelPath != _model.path || !_model.node) return;
+
+    _parentNode.removeChildNode(_model.node);
+    _model.node = node;
+    _model.loading = false;
+
+    insertModelNode(GlobalEntityClassManager().findModel(_model.path));
+
+    // Apply any explicit skin to the new model
+    if (auto skinned = std::dynamic_pointer_cast<SkinnedModel>(_model.node); skinned && !_model.explicitSkin.empty())
+    {
+        skinned->skinChanged(_model.explicitSkin);
+    }
+}
+
+std::string ModelKey::getActualModelPath() const
+{
+    auto modelDef = GlobalEntityClassManager().findModel(_model.path);
+
+    return modelDef ? modelDef->getMesh() : _model.path;
+}
+
 void ModelKey::detachModelNode()
 {
     unsubscribeFromModelDef();
 
+    _model.loading = false;
+
     if (!_model.node) return; // nothing to do
 
     _parentNode.removeChildNode(_model.node);
@@ -179,6 +215,18 @@ void ModelKey::importState(const ModelNodeAndPath& data)
 	_model.path = data.path;
 	_model.node = data.node;
     _model.modelDefMonitored = data.modelDefMonitored;
+    _model.loading = data.loading;
+
+    // Models requested before the undo must not replace the restored node
+    ++_modelRequest;
+
+    // A restored placeholder still needs its model, the request of the
+    // placeholder has been superseded so ask for the model again
+    if (_active && _model.loading && _model.node)
+    {
+        GlobalModelCache().requestModelNode(getActualModelPath(), sigc::bind(
+            sigc::mem_fun(*this, &ModelKey::onModelLoaded), _modelRequest, _model.path));
+    }
 
     if (_model.modelDefMonitored)
     {
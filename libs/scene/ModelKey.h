@@ -25,6 +25,9 @@ private:
 		std::string path;
         std::string explicitSkin;
         bool modelDefMonitored;
+
+        // TRUE while the node is a placeholder waiting for the background loader
+        bool loading = false;
 	};
 
 	ModelNodeAndPath _model;
@@ -32,6 +35,10 @@ private:
 	// To deactivate model handling during node destruction
 	bool _active;
 
+	// Incremented with every model request, to recognise outdated
+	// models arriving from the background loader
+	std::size_t _modelRequest;
+
 	// Saves modelnode and modelpath to undo stack
 	undo::ObservedUndoable<ModelNodeAndPath> _undo;
 
@@ -69,6 +76,15 @@ private:
     void attachModelNode();
     void detachModelNode();
 
+    // Adds the model node to the parent, applying the modelDef settings
+    void insertModelNode(const IModelDef::Ptr& modelDef);
+
+    // Replaces the placeholder node with the model loaded in the background
+    void onModelLoaded(const scene::INodePtr& node, std::size_t modelRequest, const std::string& modelPath);
+
+    // Returns the path to request from the model cache, resolving modelDefs
+    std::string getActualModelPath() const;
+
     // Attaches a model node, making sure that the skin setting is kept
     void attachModelNodeKeepingSkin();
 
@@ -13,6 +13,7 @@ Node::Node() :
 	_state(eVisible),
 	_isRoot(false),
 	_id(getNewId()), // Get new auto-incremented ID
+	_changeStamp(++_maxChangeStamp),
 	_children(*this),
 	_boundsChanged(true),
 	_boundsMutex(false),
@@ -35,6 +36,7 @@ Node::Node(const Node& other) :
 	_state(other._state),
 	_isRoot(other._isRoot),
 	_id(getNewId()),	// ID is incremented on copy
+	_changeStamp(++_maxChangeStamp),
 	_children(*this),
 	_boundsChanged(true),
 	_boundsMutex(false),
@@ -138,11 +140,7 @@ void Node::moveToLayer(int layerId)
 void Node::removeFromLayer(int layerId)
 {
 	// Look up the layer ID and remove it from the list
-	LayerList::iterator found = _layers.find(layerId);
-
-	if (found != _layers.end()) {
-		_layers.erase(found);
-
+	if (_layers.erase(layerId) > 0) {
 		// greebo: Make sure that every node is at least member of layer 0
 		if (_layers.empty()) {
 			_layers.insert(0);
@@ -555,6 +553,7 @@ void Node::setRenderState(RenderState state)
     }
 }
 
-unsigned long Node::_maxNodeId = 0;
+std::atomic<unsigned long> Node::_maxNodeId(0);
+std::atomic<unsigned long> Node::_maxChangeStamp(0);
 
 } // namespace scene
@@ -4,6 +4,7 @@
 #include "ipath.h"
 #include "irender.h"
 #include <list>
+#include <atomic>
 #include "TraversableNodeSet.h"
 #include "math/AABB.h"
 #include "math/Matrix4.h"
@@ -34,8 +35,14 @@ private:
 	bool _isRoot;
 	unsigned long _id;
 
-	// Auto-incrementing ID (contains the largest ID in use)
-	static unsigned long _maxNodeId;
+	// Auto-incrementing ID (contains the largest ID in use), nodes
+	// might be constructed on worker threads during map loading
+	static std::atomic<unsigned long> _maxNodeId;
+
+	// Is assigned a new value whenever the node contents are changed,
+	// the values are never reused, not even for different nodes
+	unsigned long _changeStamp;
+	static std::atomic<unsigned long> _maxChangeStamp;
 
 	TraversableNodeSet _children;
 
@@ -65,6 +72,9 @@ private:
 
     RenderState _renderState;
 
+	// Space partition book-keeping, is never copied along with the node
+	SpacePartitionSlot _spacePartitionSlot;
+
 protected:
 	// If this node is attached to a parent entity, this is the reference to it
     IRenderEntity* _renderEntity;
@@ -84,6 +94,22 @@ public:
 	static void resetIds();
 	static unsigned long getNewId();
 
+	/**
+	 * Returns a number which changes whenever the contents of this node are
+	 * modified, as reported by the subclasses through markChanged(). Can be
+	 * used to detect whether a node is unchanged since it was last looked at.
+	 */
+	unsigned long getChangeStamp() const
+	{
+		return _changeStamp;
+	}
+
+	// Is called by the subclasses (or their undoable parts) before their contents change
+	void markChanged()
+	{
+		_changeStamp = ++_maxChangeStamp;
+	}
+
     // Default name for generic nodes
     std::string name() const override { return "node"; }
 
@@ -203,6 +229,11 @@ public:
     RenderState getRenderState() const override;
     void setRenderState(RenderState state) override;
 
+	SpacePartitionSlot& getSpacePartitionSlot() override
+	{
+		return _spacePartitionSlot;
+	}
+
 protected:
     virtual void onRenderStateChanged()
     {}
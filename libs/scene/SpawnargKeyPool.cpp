@@ -0,0 +1,58 @@
+#include "SpawnargKeyPool.h"
+
+#include <cctype>
+#include <mutex>
+#include "string/predicate.h"
+
+namespace entity
+{
+
+std::size_t SpawnargKeyPool::CaseInsensitiveHash::operator()(const std::string& key) const
+{
+    // FNV-1a on the lower case characters
+    std::size_t hash = 14695981039346656037ULL;
+
+    for (auto c : key)
+    {
+        hash ^= static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+bool SpawnargKeyPool::CaseInsensitiveEqual::operator()(const std::string& a, const std::string& b) const
+{
+    return string::iequals(a, b);
+}
+
+SpawnargKeyPool& SpawnargKeyPool::Instance()
+{
+    static SpawnargKeyPool _instance;
+    return _instance;
+}
+
+SpawnargKeyPool::Atom SpawnargKeyPool::GetAtom(const std::string& key)
+{
+    auto atom = FindAtom(key);
+
+    if (atom != NoAtom) return atom;
+
+    auto& pool = Instance();
+    std::unique_lock<std::shared_mutex> lock(pool._lock);
+
+    // Another thread might have been faster, emplace won't overwrite its atom
+    return pool._atoms.emplace(key, static_cast<Atom>(pool._atoms.size() + 1)).first->second;
+}
+
+SpawnargKeyPool::Atom SpawnargKeyPool::FindAtom(const std::string& key)
+{
+    auto& pool = Instance();
+    std::shared_lock<std::shared_mutex> lock(pool._lock);
+
+    auto found = pool._atoms.find(key);
+
+    return found != pool._atoms.end() ? found->second : NoAtom;
+}
+
+}
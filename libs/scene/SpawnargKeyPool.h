@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace entity
+{
+
+/**
+ * Process-wide pool of spawnarg keys. Every distinct key (compared
+ * case-insensitively, like the game does) is assigned a numeric atom,
+ * such that entities can look up their keys by comparing integers
+ * instead of strings.
+ *
+ * Atoms are valid for the lifetime of the process, the pool is safe
+ * to be used from multiple threads.
+ */
+class SpawnargKeyPool
+{
+public:
+    using Atom = std::uint32_t;
+
+    // Never assigned to any key
+    static constexpr Atom NoAtom = 0;
+
+    // Returns the atom of the given key, assigns a new one if necessary
+    static Atom GetAtom(const std::string& key);
+
+    // Returns the atom of the given key, or NoAtom if the key has never been assigned one
+    static Atom FindAtom(const std::string& key);
+
+private:
+    struct CaseInsensitiveHash
+    {
+        std::size_t operator()(const std::string& key) const;
+    };
+
+    struct CaseInsensitiveEqual
+    {
+        bool operator()(const std::string& a, const std::string& b) const;
+    };
+
+    std::shared_mutex _lock;
+    std::unordered_map<std::string, Atom, CaseInsensitiveHash, CaseInsensitiveEqual> _atoms;
+
+    static SpawnargKeyPool& Instance();
+};
+
+}
@@ -5,6 +5,7 @@
 #include "imap.h"
 #include "iselectiongroup.h"
 #include "inode.h"
+#include "icomparablenode.h"
 
 namespace scene
 {
@@ -27,7 +28,7 @@ public:
     // Represents a matching node pair
     struct Match
     {
-        std::string fingerPrint;
+        Fingerprint fingerPrint;
         INodePtr sourceNode;
         INodePtr baseNode;
     };
@@ -55,7 +56,7 @@ public:
 
     struct PrimitiveDifference
     {
-        std::string fingerprint;
+        Fingerprint fingerprint;
         INodePtr node;
 
         enum class Type
@@ -72,8 +73,8 @@ public:
         INodePtr sourceNode;
         INodePtr baseNode;
         std::string entityName;
-        std::string sourceFingerprint;
-        std::string baseFingerprint;
+        Fingerprint sourceFingerprint;
+        Fingerprint baseFingerprint;
 
         enum class Type
         {
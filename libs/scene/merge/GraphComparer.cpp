@@ -6,7 +6,6 @@
 #include "itextstream.h"
 #include "iselectiongroup.h"
 #include "icomparablenode.h"
-#include "math/Hash.h"
 #include "scenelib.h"
 #include "string/string.h"
 #include "command/ExecutionNotPossible.h"
@@ -122,7 +121,7 @@ void GraphComparer::processDifferingEntities(ComparisonResult& result, const Ent
             INodePtr(), // source node is empty
             mismatch.second.node,
             mismatch.second.entityName,
-            std::string(),// source fingerprint is empty
+            Fingerprint(),// source fingerprint is empty
             mismatch.second.fingerPrint, // base fingerprint
             ComparisonResult::EntityDifference::Type::EntityMissingInSource
         });
@@ -136,7 +135,7 @@ void GraphComparer::processDifferingEntities(ComparisonResult& result, const Ent
             INodePtr(), // base node is empty
             mismatch.second.entityName,
             mismatch.second.fingerPrint, // source fingerprint
-            std::string(),// base fingerprint is empty
+            Fingerprint(),// base fingerprint is empty
             ComparisonResult::EntityDifference::Type::EntityMissingInBase
         });
     }
@@ -233,21 +232,10 @@ std::list<ComparisonResult::PrimitiveDifference> GraphComparer::compareChildNode
     auto sourceChildren = NodeUtils::CollectPrimitiveFingerprints(sourceNode);
     auto baseChildren = NodeUtils::CollectPrimitiveFingerprints(baseNode);
 
-    std::vector<Fingerprints::value_type> missingInSource;
-    std::vector<Fingerprints::value_type> missingInBase;
-
-    auto compareFingerprint = [](const Fingerprints::value_type& left, const Fingerprints::value_type& right)
+    for (const auto& pair : sourceChildren)
     {
-        return left.first < right.first;
-    };
-
-    std::set_difference(sourceChildren.begin(), sourceChildren.end(),
-        baseChildren.begin(), baseChildren.end(), std::back_inserter(missingInBase), compareFingerprint);
-    std::set_difference(baseChildren.begin(), baseChildren.end(),
-        sourceChildren.begin(), sourceChildren.end(), std::back_inserter(missingInSource), compareFingerprint);
+        if (baseChildren.count(pair.first) > 0) continue;
 
-    for (const auto& pair : missingInBase)
-    {
         result.emplace_back(ComparisonResult::PrimitiveDifference
         {
             pair.first,
@@ -256,8 +244,10 @@ std::list<ComparisonResult::PrimitiveDifference> GraphComparer::compareChildNode
         });
     }
 
-    for (const auto& pair : missingInSource)
+    for (const auto& pair : baseChildren)
     {
+        if (sourceChildren.count(pair.first) > 0) continue;
+
         result.emplace_back(ComparisonResult::PrimitiveDifference
         {
             pair.first,
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "inode.h"
+#include "icomparablenode.h"
 #include "imap.h"
 #include "itextstream.h"
 
@@ -25,12 +26,10 @@ namespace merge
 class GraphComparer
 {
 private:
-    using Fingerprints = std::map<std::string, INodePtr>;
-
 public:
     struct EntityMismatch
     {
-        std::string fingerPrint;
+        Fingerprint fingerPrint;
         INodePtr node;
         std::string entityName;
     };
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 #include "inode.h"
 #include "icomparablenode.h"
 #include "ientity.h"
 #include "itextstream.h"
 #include "scene/Entity.h"
+#include "util/Parallel.h"
 
 namespace scene
 {
@@ -13,7 +15,7 @@ namespace scene
 namespace merge
 {
 
-using Fingerprints = std::map<std::string, INodePtr>;
+using Fingerprints = std::unordered_map<Fingerprint, INodePtr>;
 
 class NodeUtils
 {
@@ -53,10 +55,14 @@ public:
     }
 
 private:
+    // Fingerprints of a parent's children are calculated on multiple threads
+    // if there are at least this many children per thread
+    static constexpr std::size_t MinNodesPerThread = 32;
+
     static Fingerprints CollectNodeFingerprints(const INodePtr& parent,
         const std::function<bool(const INodePtr& node)>& nodePredicate)
     {
-        Fingerprints result;
+        std::vector<std::shared_ptr<IComparableNode>> nodes;
 
         parent->foreachNode([&](const INodePtr& node)
         {
@@ -67,16 +73,38 @@ private:
 
             if (!comparable) return true; // skip
 
+            nodes.emplace_back(std::move(comparable));
+            return true;
+        });
+
+        // Calculating the fingerprints is the expensive part. Entity fingerprints
+        // vary a lot in cost, let the threads pick small chunks of nodes.
+        std::vector<Fingerprint> fingerprints(nodes.size());
+
+        auto numThreads = util::getParallelThreadCount(nodes.size(), MinNodesPerThread);
+
+        util::processChunksInParallel(nodes.size(), std::min(nodes.size(), numThreads * 16), numThreads,
+            [&](std::size_t, std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                fingerprints[i] = nodes[i]->getFingerprint();
+            }
+        });
+
+        Fingerprints result;
+        result.reserve(nodes.size());
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
             // Store the fingerprint and check for collisions
-            auto insertResult = result.try_emplace(comparable->getFingerprint(), node);
+            auto insertResult = result.try_emplace(fingerprints[i], nodes[i]);
 
             if (!insertResult.second)
             {
                 rWarning() << "More than one node with the same fingerprint found in the parent node with name " << parent->name() << std::endl;
             }
-
-            return true;
-        });
+        }
 
         return result;
     }
@@ -94,7 +122,7 @@ private:
 
         if (comparable)
         {
-            return comparable->getFingerprint();
+            return comparable->getFingerprint().toString();
         }
 
         return std::string();
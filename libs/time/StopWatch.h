@@ -52,6 +52,17 @@ public:
 
 		return static_cast<std::size_t>(msecs);
 	}
+
+	// Returns the microseconds passed since the last call to restart()
+	// If restart() has never been called, this is the duration since construction
+	std::size_t getMicroSecondsPassed() const
+	{
+		auto endTime = _clock.now();
+
+		auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - _start).count();
+
+		return static_cast<std::size_t>(usecs);
+	}
 };
 
 }
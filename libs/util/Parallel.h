@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+
+/// Returns the number of threads to use when processing the given amount of
+/// items, such that each thread gets at least minItemsPerThread items.
+/// The result is limited by the hardware concurrency and is never below 1.
+inline std::size_t getParallelThreadCount(std::size_t numItems, std::size_t minItemsPerThread)
+{
+    std::size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::size_t threadsForItems = numItems / std::max(minItemsPerThread, std::size_t(1));
+
+    return std::max(std::min(hardwareThreads, threadsForItems), std::size_t(1));
+}
+
+/**
+ * Splits the range [0, numItems) into numChunks contiguous chunks of nearly
+ * equal size and processes them on up to numThreads threads (the calling thread
+ * being one of them). Each thread picks the next unprocessed chunk until all of
+ * them are done, the chunks are passed as chunkFunc(chunkIndex, begin, end).
+ *
+ * Blocks until all chunks have been processed. Exceptions thrown by the chunk
+ * function are propagated to the caller once all threads are done.
+ */
+template<typename ChunkFunc>
+void processChunksInParallel(std::size_t numItems, std::size_t numChunks, std::size_t numThreads,
+    const ChunkFunc& chunkFunc)
+{
+    std::atomic<std::size_t> nextChunk(0);
+
+    auto worker = [&]()
+    {
+        for (auto chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+        {
+            chunkFunc(chunk, numItems * chunk / numChunks, numItems * (chunk + 1) / numChunks);
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+
+    for (std::size_t i = 1; i < std::min(numThreads, numChunks); ++i)
+    {
+        workers.emplace_back(std::async(std::launch::async, worker));
+    }
+
+    worker();
+
+    for (auto& future : workers)
+    {
+        future.get();
+    }
+}
+
+}
@@ -0,0 +1,40 @@
+#include "ModelLoadingTimer.h"
+
+#include "imodelcache.h"
+
+namespace map
+{
+
+namespace
+{
+    // Models are usually parsed in a few milliseconds, check often
+    constexpr int CHECK_INTERVAL_MSECS = 50;
+}
+
+ModelLoadingTimer::~ModelLoadingTimer()
+{
+    if (_timer)
+    {
+        _timer->Stop();
+    }
+
+    // Destroy the timer
+    _timer.reset();
+}
+
+void ModelLoadingTimer::initialise()
+{
+    _timer.reset(new wxTimer(this));
+
+    Bind(wxEVT_TIMER, &ModelLoadingTimer::onIntervalReached, this);
+
+    _timer->Start(CHECK_INTERVAL_MSECS);
+}
+
+void ModelLoadingTimer::onIntervalReached(wxTimerEvent& ev)
+{
+    // This swaps the placeholder nodes and triggers a redraw if anything arrived
+    GlobalModelCache().processLoadedModels();
+}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <wx/timer.h>
+#include <wx/sharedptr.h>
+
+namespace map
+{
+
+/**
+ * Timer object which regularly hands the models loaded in the background
+ * over to the entities waiting for them.
+ */
+class ModelLoadingTimer final :
+    public wxEvtHandler
+{
+private:
+    // The timer object that triggers the callback
+    wxSharedPtr<wxTimer> _timer;
+
+public:
+    ~ModelLoadingTimer();
+
+    void initialise();
+
+private:
+    void onIntervalReached(wxTimerEvent& ev);
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <wx/stopwatch.h>
+#include "iscenegraph.h"
 #include "string/string.h"
 
 namespace render
@@ -15,6 +16,13 @@ class RenderStatistics
     // Time for the render front-end only
     long _feTime = 0;
 
+    // Scenegraph bounds update counters at the end of the previous front-end pass
+    scene::Graph::BoundsUpdateStatistics _lastBoundsStats;
+
+    // Bounds changes and the space partition re-links they caused in this frame
+    std::size_t _boundsChanges = 0;
+    std::size_t _relinks = 0;
+
 public:
 
     /// Return the constructed string for display
@@ -27,13 +35,20 @@ public:
         return " | f/e: " + std::to_string(_feTime) + " ms"
              + " | b/e: " + std::to_string(beTime) + " ms"
              + " | tot: " + std::to_string(totTime) + " ms"
-             + " | fps: " + (totTime > 0 ? std::to_string(1000 / totTime) : "-");
+             + " | fps: " + (totTime > 0 ? std::to_string(1000 / totTime) : "-")
+             + " | relinks: " + std::to_string(_relinks) + "/" + std::to_string(_boundsChanges);
     }
 
     /// Mark the front-end render stage as completed, storing the time internally
     void frontEndComplete()
     {
         _feTime = _timer.Time();
+
+        auto boundsStats = GlobalSceneGraph().getBoundsUpdateStatistics();
+
+        _boundsChanges = boundsStats.boundsChanges - _lastBoundsStats.boundsChanges;
+        _relinks = boundsStats.relinks - _lastBoundsStats.relinks;
+        _lastBoundsStats = boundsStats;
     }
 
     /// Reset statistics at the beginning of a frame render
@@ -0,0 +1,45 @@
+#include "TextureLoadingTimer.h"
+
+#include "ishaders.h"
+#include "iscenegraph.h"
+
+namespace render
+{
+
+namespace
+{
+    // Roughly one check per frame, uploads are limited per frame anyway
+    constexpr int CHECK_INTERVAL_MSECS = 20;
+}
+
+TextureLoadingTimer::~TextureLoadingTimer()
+{
+    if (_timer)
+    {
+        _timer->Stop();
+    }
+
+    // Destroy the timer
+    _timer.reset();
+}
+
+void TextureLoadingTimer::initialise()
+{
+    _timer.reset(new wxTimer(this));
+
+    Bind(wxEVT_TIMER, &TextureLoadingTimer::onIntervalReached, this);
+
+    _timer->Start(CHECK_INTERVAL_MSECS);
+}
+
+void TextureLoadingTimer::onIntervalReached(wxTimerEvent& ev)
+{
+    // The uploads happen when the render system starts the next frame,
+    // keep asking for one until the upload queue has been drained
+    if (GlobalMaterialManager().hasPendingTextureUploads())
+    {
+        SceneChangeNotify();
+    }
+}
+
+}
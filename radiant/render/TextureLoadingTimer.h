@@ -0,0 +1,29 @@
+#pragma once
+
+#include <wx/timer.h>
+#include <wx/sharedptr.h>
+
+namespace render
+{
+
+/**
+ * Timer object which keeps requesting redraws while textures loaded
+ * in the background are waiting to be uploaded at the start of a frame.
+ */
+class TextureLoadingTimer final :
+    public wxEvtHandler
+{
+private:
+    // The timer object that triggers the callback
+    wxSharedPtr<wxTimer> _timer;
+
+public:
+    ~TextureLoadingTimer();
+
+    void initialise();
+
+private:
+    void onIntervalReached(wxTimerEvent& ev);
+};
+
+}
@@ -9,6 +9,7 @@
 #include "scene/Entity.h"
 #include "imru.h"
 #include "imap.h"
+#include "imodelcache.h"
 #include "ibrush.h"
 #include "ipatch.h"
 #include "iclipper.h"
@@ -127,6 +128,7 @@ const StringSet& UserInterfaceModule::getDependencies() const
 		MODULE_EDITING_STOPWATCH,
 		MODULE_COUNTER,
 		MODULE_CLIPPER,
+		MODULE_MODELCACHE,
 	};
 
 	return _dependencies;
@@ -241,6 +243,12 @@ void UserInterfaceModule::initialiseModule(const IApplicationContext& ctx)
 	_autosaveTimer.reset(new map::AutoSaveTimer);
 	_autosaveTimer->initialise();
 
+	_modelLoadingTimer.reset(new map::ModelLoadingTimer);
+	_modelLoadingTimer->initialise();
+
+	_textureLoadingTimer.reset(new render::TextureLoadingTimer);
+	_textureLoadingTimer->initialise();
+
 #ifdef WIN32
 	// Hide the local user guide item in Windows
 	GlobalMainFrame().signal_MainFrameConstructed().connect([&]()
@@ -312,6 +320,8 @@ void UserInterfaceModule::shutdownModule()
 	_viewMenu.reset();
 	_userControls.clear();
 	_autosaveTimer.reset();
+	_modelLoadingTimer.reset();
+	_textureLoadingTimer.reset();
 
 	wxTheApp->Unbind(DISPATCH_EVENT, &UserInterfaceModule::onDispatchEvent, this);
 
@@ -26,6 +26,8 @@
 #include "DispatchEvent.h"
 #include "mainframe/ViewMenu.h"
 #include "map/AutoSaveTimer.h"
+#include "map/ModelLoadingTimer.h"
+#include "render/TextureLoadingTimer.h"
 #include "textool/TexToolModeToggles.h"
 
 namespace ui
@@ -70,6 +72,8 @@ private:
 	std::unique_ptr<MRUMenu> _mruMenu;
 
 	std::unique_ptr<map::AutoSaveTimer> _autosaveTimer;
+	std::unique_ptr<map::ModelLoadingTimer> _modelLoadingTimer;
+	std::unique_ptr<render::TextureLoadingTimer> _textureLoadingTimer;
 
 	std::unique_ptr<ViewMenu> _viewMenu;
 
@@ -313,6 +313,8 @@ void Brush::appendFaces(const Faces& other) {
 
 void Brush::undoSave()
 {
+	_owner.markChanged();
+
 	if (_undoStateSaver != nullptr)
 	{
 		_undoStateSaver->saveState();
@@ -448,8 +450,13 @@ void Brush::onFaceShaderChanged()
 	// When the face shader changes, no geometry change is happening
 	// therefore no call to onFacePlaneChanged() is necessary
 
-	// Queue an UI update of the texture tools if any of them is listening
-	signal_faceShaderChanged().emit();
+	// Queue an UI update of the texture tools if any of them is listening.
+	// Brushes outside the scene are of no interest to them, this also keeps
+	// brushes constructed by the map loader's worker threads off the UI.
+	if (_owner.inScene())
+	{
+		signal_faceShaderChanged().emit();
+	}
 }
 
 void Brush::onFaceConnectivityChanged()
@@ -4,7 +4,7 @@
 #include "icounter.h"
 #include "iclipper.h"
 #include "imap.h"
-#include "math/Hash.h"
+#include "math/FastHash.h"
 #include <functional>
 
 BrushNode::BrushNode() :
@@ -59,16 +59,16 @@ const AABB& BrushNode::localAABB() const {
 	return _brush.localAABB();
 }
 
-std::string BrushNode::getFingerprint()
+scene::Fingerprint BrushNode::getFingerprint()
 {
 	constexpr std::size_t SignificantDigits = scene::SignificantFingerprintDoubleDigits;
 
 	if (_brush.getNumFaces() == 0)
 	{
-		return std::string(); // empty brushes produce an empty fingerprint
+		return scene::Fingerprint(); // empty brushes produce an empty fingerprint
 	}
 
-	math::Hash hash;
+	math::FastHash hash;
 
 	hash.addSizet(static_cast<std::size_t>(_brush.getDetailFlag() + 1));
 
@@ -82,7 +82,7 @@ public:
 	Type getNodeType() const override;
 
 	// IComparable implementation
-	std::string getFingerprint() override;
+	scene::Fingerprint getFingerprint() override;
 
 	// Bounded implementation
 	const AABB& localAABB() const override;
@@ -192,6 +192,8 @@ void Face::disconnectUndoSystem(IUndoSystem& undoSystem)
 
 void Face::undoSave()
 {
+    _owner.getBrushNode().markChanged();
+
     if (_undoStateSaver)
     {
         _undoStateSaver->saveState();
@@ -411,7 +413,11 @@ void Face::shaderChanged()
     _faceIsVisible = shader && shader->getMaterial()->isVisible();
 
     planeChanged(); // updates renderables too
-    SceneChangeNotify();
+
+    if (_owner.getBrushNode().inScene())
+    {
+        SceneChangeNotify();
+    }
 }
 
 const std::string& Face::getShader() const
@@ -1,6 +1,8 @@
 #include "CSG.h"
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "i18n.h"
 #include "itextstream.h"
@@ -14,6 +16,8 @@
 #include "selectionlib.h"
 
 #include "registry/registry.h"
+#include "render/AABBVolumeTest.h"
+#include "time/StopWatch.h"
 #include "brush/Face.h"
 #include "brush/Brush.h"
 #include "brush/BrushNode.h"
@@ -166,14 +170,15 @@ bool Brush_subtract(const BrushNodePtr& brush, const Brush& other, BrushPtrVecto
 	return false;
 }
 
-class SubtractBrushesFromUnselected :
-	public scene::NodeVisitor
+class SubtractBrushesFromUnselected
 {
 	const BrushPtrVector& _brushlist;
 	std::size_t& _before;
 	std::size_t& _after;
 
-	BrushPtrVector _unselectedBrushes;
+	// The visible unselected brushes touching any of the selected ones,
+	// along with the indices of the selected brushes they're touching
+	std::vector<std::pair<BrushNodePtr, std::vector<std::size_t>>> _unselectedBrushes;
 
 public:
 	SubtractBrushesFromUnselected(const BrushPtrVector& brushlist, std::size_t& before, std::size_t& after) :
@@ -182,31 +187,66 @@ public:
 		_after(after)
 	{}
 
-	bool pre(const scene::INodePtr& node) override
+	// Queries the space partition for the unselected brushes near each selected brush,
+	// returns the number of nodes looked at
+	std::size_t findUnselectedBrushes()
 	{
-		if (!node->visible())
-		{
-			return false;
-		}
+		std::unordered_map<scene::INode*, std::size_t> brushIndices;
+		std::unordered_set<scene::INode*> visited;
 
-		if (Node_isBrush(node) && !Node_isSelected(node))
+		for (std::size_t i = 0; i < _brushlist.size(); ++i)
 		{
-			_unselectedBrushes.emplace_back(std::dynamic_pointer_cast<BrushNode>(node));
+			render::AABBVolumeTest volume(_brushlist[i]->worldAABB());
+
+			GlobalSceneGraph().foreachVisibleNodeInVolume(volume, [&](const scene::INodePtr& node)
+			{
+				visited.insert(node.get());
+
+				if (!Node_isBrush(node) || Node_isSelected(node) || !isParentVisible(node))
+				{
+					return true;
+				}
+
+				auto brushNode = std::dynamic_pointer_cast<BrushNode>(node);
+
+				// Same test as in Brush_subtract, brushes not passing it are left alone anyway
+				if (!brushNode->getBrush().localAABB().intersects(_brushlist[i]->getBrush().localAABB()))
+				{
+					return true;
+				}
+
+				auto existing = brushIndices.emplace(node.get(), _unselectedBrushes.size());
+
+				if (existing.second)
+				{
+					_unselectedBrushes.emplace_back(brushNode, std::vector<std::size_t>());
+				}
+
+				_unselectedBrushes[existing.first->second].second.push_back(i);
+				return true;
+			});
 		}
 
-		return true;
+		return visited.size();
 	}
 
 	void processUnselectedBrushes()
 	{
-		for (const auto& node : _unselectedBrushes)
+		for (const auto& [node, selectedBrushes] : _unselectedBrushes)
 		{
-			processNode(node);
+			processNode(node, selectedBrushes);
 		}
 	}
 
 private:
-	void processNode(const BrushNodePtr& brushNode)
+	// Brushes of hidden entities are not considered
+	static bool isParentVisible(const scene::INodePtr& node)
+	{
+		auto parent = node->getParent();
+		return parent && (parent->isRoot() || parent->visible());
+	}
+
+	void processNode(const BrushNodePtr& brushNode, const std::vector<std::size_t>& selectedBrushes)
 	{
 		// Get the parent of this brush
 		scene::INodePtr parent = brushNode->getParent();
@@ -220,9 +260,11 @@ private:
 		//Brush* original = new Brush(*brush);
 		buffer[swap].push_back(original);
 
-		// Iterate over all selected brushes
-		for (const auto& selectedBrush : _brushlist)
+		// Iterate over the selected brushes touching this one, in selection order
+		for (auto index : selectedBrushes)
 		{
+			const auto& selectedBrush = _brushlist[index];
+
 			for (const auto& target : buffer[swap])
 			{
 				if (Brush_subtract(target, selectedBrush->getBrush(), buffer[1 - swap]))
@@ -303,15 +345,20 @@ void subtractBrushesFromUnselected(const cmd::ArgumentList& args)
 	std::size_t before = 0;
 	std::size_t after = 0;
 
-	SubtractBrushesFromUnselected walker(brushes, before, after);
-	GlobalSceneGraph().root()->traverse(walker);
+	util::StopWatch timer;
+
+	SubtractBrushesFromUnselected subtraction(brushes, before, after);
+	auto numCandidates = subtraction.findUnselectedBrushes();
 
-	walker.processUnselectedBrushes();
+	subtraction.processUnselectedBrushes();
 
 	rMessage() << "CSG Subtract: Result: "
 		<< after << " fragment" << (after == 1 ? "" : "s")
 		<< " from " << before << " brush" << (before == 1 ? "" : "es") << ".\n";
 
+	rMessage() << "CSG Subtract: Looked at " << numCandidates << " nodes in "
+		<< timer.getMilliSecondsPassed() << " ms.\n";
+
 	SceneChangeNotify();
 }
 
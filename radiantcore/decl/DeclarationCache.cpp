@@ -0,0 +1,359 @@
+#include "DeclarationCache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include "itextstream.h"
+#include "stream/utils.h"
+#include "fmt/format.h"
+
+namespace decl
+{
+
+namespace
+{
+    constexpr const char* const CACHE_FILE_EXTENSION = ".declcache";
+
+    // Four magic bytes followed by the format version
+    constexpr char CACHE_FILE_MAGIC[4] = { 'D', 'R', 'D', 'C' };
+    constexpr std::uint32_t CACHE_FILE_VERSION = 1;
+
+    struct ArchiveFingerprint
+    {
+        std::uint64_t size = 0;
+        std::int64_t lastModified = 0;
+
+        bool operator==(const ArchiveFingerprint& other) const
+        {
+            return size == other.size && lastModified == other.lastModified;
+        }
+    };
+
+    bool getArchiveFingerprint(const std::string& archivePath, ArchiveFingerprint& fingerprint)
+    {
+#ifdef DR_USE_STD_FILESYSTEM
+        std::error_code ec;
+#else
+        boost::system::error_code ec;
+#endif
+        auto size = fs::file_size(archivePath, ec);
+        if (ec) return false;
+
+        auto lastModified = fs::last_write_time(archivePath, ec);
+        if (ec) return false;
+
+        fingerprint.size = static_cast<std::uint64_t>(size);
+#ifdef DR_USE_STD_FILESYSTEM
+        fingerprint.lastModified = static_cast<std::int64_t>(lastModified.time_since_epoch().count());
+#else
+        fingerprint.lastModified = static_cast<std::int64_t>(lastModified);
+#endif
+        return true;
+    }
+
+    // FNV-1a, the cache file names need to be stable across sessions
+    std::uint64_t getStableHash(const std::string& input)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        for (auto c : input)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    void writeString(std::ostream& stream, const std::string& value)
+    {
+        stream::writeLittleEndian<std::uint32_t>(stream, static_cast<std::uint32_t>(value.size()));
+        stream.write(value.data(), value.size());
+    }
+
+    // Reads the values of a cache file which has been loaded into memory as a whole
+    class BufferReader
+    {
+    private:
+        const char* _cur;
+        const char* _end;
+        bool _valid;
+
+    public:
+        BufferReader(const std::vector<char>& buffer) :
+            _cur(buffer.data()),
+            _end(buffer.data() + buffer.size()),
+            _valid(true)
+        {}
+
+        // Returns false if any read went past the end of the buffer
+        bool isValid() const
+        {
+            return _valid;
+        }
+
+        bool isAtEnd() const
+        {
+            return _cur == _end;
+        }
+
+        template<typename ValueType>
+        ValueType read()
+        {
+            ValueType value = 0;
+
+            if (!ensureAvailable(sizeof(ValueType))) return value;
+
+            std::memcpy(&value, _cur, sizeof(ValueType));
+            _cur += sizeof(ValueType);
+
+#ifdef __BIG_ENDIAN__
+            std::reverse(reinterpret_cast<char*>(&value), reinterpret_cast<char*>(&value) + sizeof(ValueType));
+#endif
+            return value;
+        }
+
+        std::string readString()
+        {
+            auto length = read<std::uint32_t>();
+
+            if (!ensureAvailable(length)) return std::string();
+
+            std::string value(_cur, length);
+            _cur += length;
+
+            return value;
+        }
+
+        bool readMagic()
+        {
+            if (!ensureAvailable(sizeof(CACHE_FILE_MAGIC))) return false;
+
+            auto matches = std::memcmp(_cur, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) == 0;
+            _cur += sizeof(CACHE_FILE_MAGIC);
+
+            return matches;
+        }
+
+    private:
+        bool ensureAvailable(std::size_t numBytes)
+        {
+            if (_valid && static_cast<std::size_t>(_end - _cur) >= numBytes)
+            {
+                return true;
+            }
+
+            _valid = false;
+            _cur = _end;
+            return false;
+        }
+    };
+}
+
+DeclarationCache::DeclarationCache() :
+    _enabled(false),
+    _hits(0),
+    _misses(0),
+    _cacheFilesWritten(0)
+{}
+
+void DeclarationCache::setCacheFolder(const fs::path& cacheFolder)
+{
+    _cacheFolder = cacheFolder;
+
+    _hits = 0;
+    _misses = 0;
+    _cacheFilesWritten = 0;
+}
+
+bool DeclarationCache::isEnabled() const
+{
+    return _enabled && !_cacheFolder.empty();
+}
+
+void DeclarationCache::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+std::unique_ptr<DeclarationCache::ArchiveContents> DeclarationCache::load(
+    const std::string& archivePath, const std::string& folderKey)
+{
+    ArchiveFingerprint fingerprint;
+
+    if (!getArchiveFingerprint(archivePath, fingerprint)) return {};
+
+    // Read the whole file in one go
+    std::ifstream stream(getCacheFilePath(archivePath, folderKey).string(), std::ios::binary | std::ios::ate);
+
+    if (!stream) return {};
+
+    auto fileSize = static_cast<std::size_t>(stream.tellg());
+    std::vector<char> buffer(fileSize);
+
+    stream.seekg(0);
+
+    if (!stream.read(buffer.data(), fileSize)) return {};
+
+    BufferReader reader(buffer);
+
+    if (!reader.readMagic() || reader.read<std::uint32_t>() != CACHE_FILE_VERSION)
+    {
+        return {};
+    }
+
+    // Check the key against the one this cache has been written for
+    if (reader.readString() != archivePath || reader.readString() != folderKey)
+    {
+        return {};
+    }
+
+    ArchiveFingerprint cachedFingerprint;
+    cachedFingerprint.size = reader.read<std::uint64_t>();
+    cachedFingerprint.lastModified = reader.read<std::int64_t>();
+
+    if (!reader.isValid() || !(cachedFingerprint == fingerprint))
+    {
+        return {};
+    }
+
+    auto contents = std::make_unique<ArchiveContents>();
+
+    auto numFiles = reader.read<std::uint32_t>();
+
+    for (std::uint32_t i = 0; i < numFiles && reader.isValid(); ++i)
+    {
+        auto fileName = reader.readString();
+        auto& file = (*contents)[fileName];
+
+        file.modName = reader.readString();
+
+        auto numBlocks = reader.read<std::uint32_t>();
+
+        for (std::uint32_t b = 0; b < numBlocks && reader.isValid(); ++b)
+        {
+            auto& block = file.blocks.emplace_back();
+
+            block.typeName = reader.readString();
+            block.name = reader.readString();
+            block.contents = reader.readString();
+        }
+    }
+
+    if (!reader.isValid() || !reader.isAtEnd())
+    {
+        rWarning() << "[DeclParser] Discarding corrupt declaration cache for " << archivePath << std::endl;
+        return {};
+    }
+
+    return contents;
+}
+
+void DeclarationCache::save(const std::string& archivePath, const std::string& folderKey, const ArchiveContents& contents)
+{
+    ArchiveFingerprint fingerprint;
+
+    if (!getArchiveFingerprint(archivePath, fingerprint)) return;
+
+    auto cacheFilePath = getCacheFilePath(archivePath, folderKey);
+    auto tempFilePath = cacheFilePath;
+    tempFilePath += ".tmp";
+
+    try
+    {
+        fs::create_directories(_cacheFolder);
+
+        {
+            std::ofstream stream(tempFilePath.string(), std::ios::binary | std::ios::trunc);
+
+            if (!stream)
+            {
+                rWarning() << "[DeclParser] Cannot write declaration cache file " << tempFilePath.string() << std::endl;
+                return;
+            }
+
+            stream.write(CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+            stream::writeLittleEndian<std::uint32_t>(stream, CACHE_FILE_VERSION);
+
+            writeString(stream, archivePath);
+            writeString(stream, folderKey);
+            stream::writeLittleEndian<std::uint64_t>(stream, fingerprint.size);
+            stream::writeLittleEndian<std::int64_t>(stream, fingerprint.lastModified);
+
+            stream::writeLittleEndian<std::uint32_t>(stream, static_cast<std::uint32_t>(contents.size()));
+
+            for (const auto& [fileName, file] : contents)
+            {
+                writeString(stream, fileName);
+                writeString(stream, file.modName);
+
+                stream::writeLittleEndian<std::uint32_t>(stream, static_cast<std::uint32_t>(file.blocks.size()));
+
+                for (const auto& block : file.blocks)
+                {
+                    writeString(stream, block.typeName);
+                    writeString(stream, block.name);
+                    writeString(stream, block.contents);
+                }
+            }
+        }
+
+        // Replace the previous cache file only after the new one has been written completely
+        fs::rename(tempFilePath, cacheFilePath);
+
+        ++_cacheFilesWritten;
+    }
+    catch (const fs::filesystem_error& ex)
+    {
+        rWarning() << "[DeclParser] Failed to write declaration cache: " << ex.what() << std::endl;
+    }
+}
+
+void DeclarationCache::clear()
+{
+    if (_cacheFolder.empty() || !fs::is_directory(_cacheFolder)) return;
+
+    std::size_t numRemoved = 0;
+
+    try
+    {
+        for (const auto& entry : fs::directory_iterator(_cacheFolder))
+        {
+            if (entry.path().extension() == CACHE_FILE_EXTENSION)
+            {
+                fs::remove(entry.path());
+                ++numRemoved;
+            }
+        }
+    }
+    catch (const fs::filesystem_error& ex)
+    {
+        rWarning() << "[DeclParser] Failed to clear declaration cache: " << ex.what() << std::endl;
+    }
+
+    rMessage() << "[DeclParser] Removed " << numRemoved << " declaration cache files" << std::endl;
+}
+
+void DeclarationCache::recordHits(std::size_t numFiles)
+{
+    _hits += numFiles;
+}
+
+void DeclarationCache::recordMisses(std::size_t numFiles)
+{
+    _misses += numFiles;
+}
+
+DeclarationCache::Statistics DeclarationCache::getStatistics() const
+{
+    return Statistics{ _hits, _misses, _cacheFilesWritten };
+}
+
+fs::path DeclarationCache::getCacheFilePath(const std::string& archivePath, const std::string& folderKey) const
+{
+    auto fileName = fmt::format("{0:016x}{1}", getStableHash(archivePath + "|" + folderKey), CACHE_FILE_EXTENSION);
+    return _cacheFolder / fileName;
+}
+
+}
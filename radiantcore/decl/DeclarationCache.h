@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "os/fs.h"
+
+namespace decl
+{
+
+/**
+ * Persistent on-disk cache of the declaration blocks found in VFS archives,
+ * allowing the decl parsers to skip tokenising files in unchanged PK4s.
+ *
+ * One cache file is written per archive and decl folder, it is keyed on the
+ * absolute path, size and modification time of the archive. As soon as the
+ * archive on disk differs from the recorded fingerprint the cache file is
+ * considered stale and will be overwritten after the next parse run.
+ *
+ * Files in physical directories are never cached.
+ *
+ * All public methods are safe to call from multiple parser threads, as long
+ * as each thread is dealing with a different folder key.
+ */
+class DeclarationCache
+{
+public:
+    struct Block
+    {
+        std::string typeName;
+        std::string name;
+        std::string contents;
+    };
+
+    struct File
+    {
+        std::string modName;
+        std::vector<Block> blocks;
+    };
+
+    // The cached files of a single archive, keyed on their VFS path
+    using ArchiveContents = std::map<std::string, File>;
+
+    struct Statistics
+    {
+        // Number of archive files served from the cache
+        std::size_t hits;
+
+        // Number of archive files which had to be parsed
+        std::size_t misses;
+
+        // Number of cache files written
+        std::size_t cacheFilesWritten;
+    };
+
+private:
+    fs::path _cacheFolder;
+
+    std::atomic<bool> _enabled;
+
+    std::atomic<std::size_t> _hits;
+    std::atomic<std::size_t> _misses;
+    std::atomic<std::size_t> _cacheFilesWritten;
+
+public:
+    DeclarationCache();
+
+    // Sets the folder the cache files are stored in, this clears the statistics
+    void setCacheFolder(const fs::path& cacheFolder);
+
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+
+    // Loads the cached contents of the given archive and folder key.
+    // Returns an empty pointer if there is no cache or if it is out of date.
+    std::unique_ptr<ArchiveContents> load(const std::string& archivePath, const std::string& folderKey);
+
+    // Writes the given contents to the cache file of the given archive and folder key
+    void save(const std::string& archivePath, const std::string& folderKey, const ArchiveContents& contents);
+
+    // Removes all cache files from disk
+    void clear();
+
+    void recordHits(std::size_t numFiles);
+    void recordMisses(std::size_t numFiles);
+
+    Statistics getStatistics() const;
+
+private:
+    fs::path getCacheFilePath(const std::string& archivePath, const std::string& folderKey) const;
+};
+
+}
@@ -1,14 +1,23 @@
 #include "DeclarationFolderParser.h"
 
+#include <numeric>
+#include <set>
 #include "DeclarationManager.h"
 #include "parser/DefBlockSyntaxParser.h"
 #include "string/trim.h"
+#include "util/Parallel.h"
 
 namespace decl
 {
 
 namespace
 {
+    // Don't bother spawning threads for less files than this
+    constexpr std::size_t MIN_FILES_PER_THREAD = 16;
+
+    // The files are split into more chunks than threads, to even out differing file sizes
+    constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
     DeclarationBlockSyntax createBlock(const parser::DefBlockSyntax& block,
         const vfs::FileInfo& fileInfo, const std::string& modName)
     {
@@ -27,16 +36,197 @@ namespace
     }
 }
 
-DeclarationFolderParser::DeclarationFolderParser(DeclarationManager& owner, Type declType, 
+DeclarationFolderParser::DeclarationFolderParser(DeclarationManager& owner, DeclarationCache& cache, Type declType,
     const std::string& baseDir, const std::string& extension,
     const std::map<std::string, Type, string::ILess>& typeMapping) :
     ThreadedDeclParser<void>(declType, baseDir, extension, 1),
     _owner(owner),
+    _cache(cache),
+    _cacheKey(getTypeName(declType) + "|" + baseDir + "|" + extension),
     _typeMapping(typeMapping),
     _defaultDeclType(declType)
 {}
 
 void DeclarationFolderParser::parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir)
+{
+    std::vector<DeclarationBlockSyntax> blocks;
+    parseBlocks(stream, fileInfo, modDir, blocks);
+    addBlocks(blocks);
+}
+
+void DeclarationFolderParser::parseFiles(const std::vector<vfs::FileInfo>& files)
+{
+    std::vector<FileResult> results(files.size());
+
+    // The archive each file is located in, this stays empty for physical files
+    std::vector<std::string> archivePaths(files.size());
+    std::vector<std::size_t> filesToParse;
+
+    if (_cache.isEnabled())
+    {
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            if (!files[i].getIsPhysicalFile())
+            {
+                archivePaths[i] = files[i].getArchivePath();
+            }
+        }
+
+        filesToParse = loadFilesFromCache(files, archivePaths, results);
+    }
+    else
+    {
+        filesToParse.resize(files.size());
+        std::iota(filesToParse.begin(), filesToParse.end(), 0);
+    }
+
+    parseFilesInParallel(files, filesToParse, results);
+
+    if (_cache.isEnabled())
+    {
+        updateCache(files, archivePaths, filesToParse, results);
+    }
+
+    // Sort the blocks into the buckets in file order, this yields the same order as a sequential run
+    for (auto& result : results)
+    {
+        addBlocks(result.blocks);
+    }
+}
+
+std::vector<std::size_t> DeclarationFolderParser::loadFilesFromCache(const std::vector<vfs::FileInfo>& files,
+    const std::vector<std::string>& archivePaths, std::vector<FileResult>& results)
+{
+    std::vector<std::size_t> filesToParse;
+    std::map<std::string, std::unique_ptr<DeclarationCache::ArchiveContents>> archives;
+
+    std::size_t numHits = 0;
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if (archivePaths[i].empty())
+        {
+            filesToParse.push_back(i);
+            continue;
+        }
+
+        // Load the cache of each archive on first use
+        auto archive = archives.find(archivePaths[i]);
+
+        if (archive == archives.end())
+        {
+            archive = archives.emplace(archivePaths[i], _cache.load(archivePaths[i], _cacheKey)).first;
+        }
+
+        if (!archive->second)
+        {
+            filesToParse.push_back(i);
+            continue;
+        }
+
+        auto cachedFile = archive->second->find(files[i].fullPath());
+
+        if (cachedFile == archive->second->end())
+        {
+            filesToParse.push_back(i);
+            continue;
+        }
+
+        auto& result = results[i];
+
+        result.modName = cachedFile->second.modName;
+        result.complete = true;
+        result.blocks.reserve(cachedFile->second.blocks.size());
+
+        for (auto& cachedBlock : cachedFile->second.blocks)
+        {
+            auto& block = result.blocks.emplace_back();
+
+            block.typeName = std::move(cachedBlock.typeName);
+            block.name = std::move(cachedBlock.name);
+            block.contents = std::move(cachedBlock.contents);
+            block.modName = result.modName;
+            block.fileInfo = files[i];
+        }
+
+        ++numHits;
+    }
+
+    _cache.recordHits(numHits);
+
+    return filesToParse;
+}
+
+void DeclarationFolderParser::parseFilesInParallel(const std::vector<vfs::FileInfo>& files,
+    const std::vector<std::size_t>& fileIndices, std::vector<FileResult>& results)
+{
+    if (fileIndices.empty()) return;
+
+    auto numThreads = util::getParallelThreadCount(fileIndices.size(), MIN_FILES_PER_THREAD);
+
+    // Each chunk is a contiguous range of files, every file is parsed into its own result slot
+    auto numChunks = numThreads == 1 ? 1 : std::min(numThreads * CHUNKS_PER_THREAD, fileIndices.size());
+
+    util::processChunksInParallel(fileIndices.size(), numChunks, numThreads,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            auto& result = results[fileIndices[i]];
+
+            parseFile(files[fileIndices[i]], [&](std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir)
+            {
+                result.modName = modDir;
+                parseBlocks(stream, fileInfo, modDir, result.blocks);
+                result.complete = true;
+            });
+        }
+    });
+}
+
+void DeclarationFolderParser::updateCache(const std::vector<vfs::FileInfo>& files,
+    const std::vector<std::string>& archivePaths, const std::vector<std::size_t>& parsedFiles,
+    const std::vector<FileResult>& results)
+{
+    std::set<std::string> staleArchives;
+    std::size_t numMisses = 0;
+
+    for (auto i : parsedFiles)
+    {
+        if (archivePaths[i].empty()) continue;
+
+        staleArchives.insert(archivePaths[i]);
+        ++numMisses;
+    }
+
+    _cache.recordMisses(numMisses);
+
+    for (const auto& archivePath : staleArchives)
+    {
+        DeclarationCache::ArchiveContents contents;
+
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            // Files with parse errors are left out, to have them reported again next time
+            if (archivePaths[i] != archivePath || !results[i].complete) continue;
+
+            auto& file = contents[files[i].fullPath()];
+
+            file.modName = results[i].modName;
+            file.blocks.reserve(results[i].blocks.size());
+
+            for (const auto& block : results[i].blocks)
+            {
+                file.blocks.push_back(DeclarationCache::Block{ block.typeName, block.name, block.contents });
+            }
+        }
+
+        _cache.save(archivePath, _cacheKey, contents);
+    }
+}
+
+void DeclarationFolderParser::parseBlocks(std::istream& stream, const vfs::FileInfo& fileInfo,
+    const std::string& modDir, std::vector<DeclarationBlockSyntax>& target)
 {
     // Parse the incoming stream into syntax blocks
     parser::DefBlockSyntaxParser<std::istream> parser(stream);
@@ -53,13 +243,21 @@ void DeclarationFolderParser::parse(std::istream& stream, const vfs::FileInfo& f
         const auto& blockNode = static_cast<const parser::DefBlockSyntax&>(*node);
 
         // Convert the incoming block to a DeclarationBlockSyntax
-        auto blockSyntax = createBlock(blockNode, fileInfo, modDir);
+        target.emplace_back(createBlock(blockNode, fileInfo, modDir));
+    }
+}
 
+void DeclarationFolderParser::addBlocks(std::vector<DeclarationBlockSyntax>& blocks)
+{
+    for (auto& block : blocks)
+    {
         // Move the block in the correct bucket
-        auto declType = determineBlockType(blockSyntax);
+        auto declType = determineBlockType(block);
         auto& blockList = _parsedBlocks.try_emplace(declType).first->second;
-        blockList.emplace_back(std::move(blockSyntax));
+        blockList.emplace_back(std::move(block));
     }
+
+    blocks.clear();
 }
 
 void DeclarationFolderParser::onFinishParsing()
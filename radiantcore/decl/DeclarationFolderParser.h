@@ -3,6 +3,7 @@
 #include <map>
 #include "ideclmanager.h"
 #include "DeclarationFile.h"
+#include "DeclarationCache.h"
 
 #include "parser/ThreadedDeclParser.h"
 #include "string/string.h"
@@ -16,11 +17,18 @@ using ParseResult = std::map<Type, std::vector<DeclarationBlockSyntax>>;
 
 // Threaded parser processing all files in the configured decl folder
 // Submits all parsed declarations to the IDeclarationManager when finished
+// Larger file sets are split into chunks and parsed on multiple threads,
+// the blocks are merged back in file order before they are submitted.
+// Files located in archives are looked up in the DeclarationCache first.
 class DeclarationFolderParser :
     public parser::ThreadedDeclParser<void>
 {
 private:
     DeclarationManager& _owner;
+    DeclarationCache& _cache;
+
+    // Identifies this parser's files in the declaration cache
+    std::string _cacheKey;
 
     // Maps typename string ("material") to Type enum (Type::Material)
     std::map<std::string, Type, string::ILess> _typeMapping;
@@ -32,7 +40,7 @@ private:
     Type _defaultDeclType;
 
 public:
-    DeclarationFolderParser(DeclarationManager& owner, Type declType,
+    DeclarationFolderParser(DeclarationManager& owner, DeclarationCache& cache, Type declType,
         const std::string& baseDir, const std::string& extension,
         const std::map<std::string, Type, string::ILess>& typeMapping);
 
@@ -44,9 +52,39 @@ public:
 
 protected:
     void parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir) override;
+    void parseFiles(const std::vector<vfs::FileInfo>& files) override;
     void onFinishParsing() override;
 
 private:
+    // Parses the blocks of the given stream, appending them to the given list
+    void parseBlocks(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir,
+        std::vector<DeclarationBlockSyntax>& target);
+
+    // The blocks of a single file, either parsed or loaded from the cache
+    struct FileResult
+    {
+        std::vector<DeclarationBlockSyntax> blocks;
+        std::string modName;
+
+        // False if the file could not be opened or parsed
+        bool complete = false;
+    };
+
+    // Looks up the given files in the cache, returns the indices of the files that need to be parsed
+    std::vector<std::size_t> loadFilesFromCache(const std::vector<vfs::FileInfo>& files,
+        const std::vector<std::string>& archivePaths, std::vector<FileResult>& results);
+
+    // Parses the given subset of files on as many threads as reasonable
+    void parseFilesInParallel(const std::vector<vfs::FileInfo>& files, const std::vector<std::size_t>& fileIndices,
+        std::vector<FileResult>& results);
+
+    // Writes new cache files for all archives containing any of the parsed files
+    void updateCache(const std::vector<vfs::FileInfo>& files, const std::vector<std::string>& archivePaths,
+        const std::vector<std::size_t>& parsedFiles, const std::vector<FileResult>& results);
+
+    // Moves the given blocks into the buckets of their respective type
+    void addBlocks(std::vector<DeclarationBlockSyntax>& blocks);
+
     Type determineBlockType(const DeclarationBlockSyntax& block);
 };
 
@@ -9,7 +9,9 @@
 #include "DeclarationFolderParser.h"
 #include "parser/DefBlockSyntaxParser.h"
 #include "ifilesystem.h"
+#include "iregistry.h"
 #include "module/StaticModule.h"
+#include "registry/registry.h"
 #include "string/trim.h"
 #include "os/path.h"
 #include "os/file.h"
@@ -21,6 +23,12 @@
 namespace decl
 {
 
+namespace
+{
+    const char* const RKEY_USE_DECL_CACHE = "user/ui/declManager/useParseCache";
+    const char* const DECL_CACHE_FOLDER = "declcache";
+}
+
 void DeclarationManager::registerDeclType(const std::string& typeName, const IDeclarationCreator::Ptr& creator)
 {
     {
@@ -69,7 +77,7 @@ void DeclarationManager::registerDeclFolder(Type defaultType, const std::string&
     auto& decls = _declarationsByType.try_emplace(defaultType, Declarations()).first->second;
 
     // Start the parser thread
-    decls.parser = std::make_unique<DeclarationFolderParser>(*this, defaultType, vfsPath, extension, getTypenameMapping());
+    decls.parser = std::make_unique<DeclarationFolderParser>(*this, _cache, defaultType, vfsPath, extension, getTypenameMapping());
     decls.parser->start();
 }
 
@@ -363,7 +371,7 @@ void DeclarationManager::runParsersForAllFolders()
         for (const auto& folder : _registeredFolders)
         {
             auto& parser = parsers.emplace_back(
-                std::make_unique<DeclarationFolderParser>(*this, folder.defaultType, folder.folder, folder.extension, typeMapping)
+                std::make_unique<DeclarationFolderParser>(*this, _cache, folder.defaultType, folder.folder, folder.extension, typeMapping)
             );
             parser->start();
         }
@@ -960,6 +968,7 @@ const StringSet& DeclarationManager::getDependencies() const
     {
         MODULE_VIRTUALFILESYSTEM,
         MODULE_COMMANDSYSTEM,
+        MODULE_XMLREGISTRY,
     };
 
     return _dependencies;
@@ -969,6 +978,13 @@ void DeclarationManager::initialiseModule(const IApplicationContext& ctx)
 {
     GlobalCommandSystem().addCommand("ReloadDecls",
         std::bind(&DeclarationManager::reloadDeclsCmd, this, std::placeholders::_1));
+    GlobalCommandSystem().addCommand("RebuildDeclCache",
+        std::bind(&DeclarationManager::rebuildDeclCacheCmd, this, std::placeholders::_1));
+    GlobalCommandSystem().addCommand("ShowDeclCacheStats",
+        std::bind(&DeclarationManager::showDeclCacheStatsCmd, this, std::placeholders::_1));
+
+    _cache.setCacheFolder(os::standardPathWithSlash(ctx.getCacheDataPath()) + DECL_CACHE_FOLDER);
+    _cache.setEnabled(registry::getValue<bool>(RKEY_USE_DECL_CACHE));
 
     // After the initial parsing, all decls will have a parseStamp of 0
     _parseStamp = 0;
@@ -1011,6 +1027,33 @@ void DeclarationManager::reloadDeclsCmd(const cmd::ArgumentList& _)
     reloadDeclarations();
 }
 
+void DeclarationManager::rebuildDeclCacheCmd(const cmd::ArgumentList& _)
+{
+    if (!_cache.isEnabled())
+    {
+        rWarning() << "The declaration cache is disabled, set " << RKEY_USE_DECL_CACHE << " to enable it" << std::endl;
+        return;
+    }
+
+    // Don't pull the files away from any running parser
+    waitForTypedParsersToFinish();
+
+    // Removing the cache files forces a full parse, which writes them anew
+    _cache.clear();
+    reloadDeclarations();
+
+    showDeclCacheStatsCmd({});
+}
+
+void DeclarationManager::showDeclCacheStatsCmd(const cmd::ArgumentList& _)
+{
+    auto stats = _cache.getStatistics();
+
+    rMessage() << "[DeclManager] Declaration cache " << (_cache.isEnabled() ? "enabled" : "disabled") <<
+        ", files loaded from cache: " << stats.hits << ", files parsed: " << stats.misses <<
+        ", cache files written: " << stats.cacheFilesWritten << std::endl;
+}
+
 module::StaticModuleRegistration<DeclarationManager> _declManagerModule;
 
 }
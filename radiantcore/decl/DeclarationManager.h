@@ -10,6 +10,7 @@
 
 #include "DeclarationFile.h"
 #include "DeclarationFolderParser.h"
+#include "DeclarationCache.h"
 
 namespace decl
 {
@@ -73,6 +74,9 @@ private:
 
     sigc::connection _vfsInitialisedConn;
 
+    // Optional on-disk cache of the blocks found in archives, shared by all parsers
+    DeclarationCache _cache;
+
     // Access allowed if the _declarationAndCreatorLock is owned
     std::vector<std::shared_ptr<std::shared_future<void>>> _parserCleanupTasks;
 
@@ -120,6 +124,8 @@ private:
     void doWithDeclarationLock(Type type, const std::function<void(NamedDeclarations&)>& action);
     void handleUnrecognisedBlocks();
     void reloadDeclsCmd(const cmd::ArgumentList& args);
+    void rebuildDeclCacheCmd(const cmd::ArgumentList& args);
+    void showDeclCacheStatsCmd(const cmd::ArgumentList& args);
 
     // Requires the creatorsMutex to be locked
     std::string getTypenameByType(Type type);
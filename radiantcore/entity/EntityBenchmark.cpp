@@ -0,0 +1,124 @@
+#include "EntityBenchmark.h"
+
+#include <algorithm>
+#include <fmt/format.h>
+
+#include "imap.h"
+#include "itextstream.h"
+#include "scene/Clone.h"
+#include "scene/EntityNode.h"
+#include "string/case_conv.h"
+#include "time/StopWatch.h"
+
+namespace entity
+{
+
+namespace
+{
+	constexpr int DEFAULT_ROUNDS = 10;
+
+	// Looked up on every entity, most of them are usually not present and fall back to the eclass
+	const char* const COMMON_KEYS[] = { "classname", "name", "origin", "model", "target", "light_radius", "editor_color" };
+
+	std::string formatRate(std::size_t operations, std::size_t usecs)
+	{
+		return fmt::format("{0:8.2f} ms ({1:8.2f} M/s)", usecs / 1000.0,
+			usecs > 0 ? static_cast<double>(operations) / usecs : 0.0);
+	}
+}
+
+void benchmarkEntityKeyValues(const cmd::ArgumentList& args)
+{
+	auto root = GlobalMapModule().getRoot();
+
+	if (!root)
+	{
+		rWarning() << "Usage: BenchmarkEntityKeyValues [<rounds>], needs a loaded map" << std::endl;
+		return;
+	}
+
+	auto rounds = args.empty() ? DEFAULT_ROUNDS : std::max(args[0].getInt(), 1);
+
+	std::vector<scene::INodePtr> entityNodes;
+	std::vector<std::string> keys;
+
+	root->foreachNode([&](const scene::INodePtr& node)
+	{
+		if (Node_isEntity(node))
+		{
+			entityNodes.push_back(node);
+		}
+
+		return true;
+	});
+
+	std::size_t numKeys = 0;
+
+	for (const auto& node : entityNodes)
+	{
+		Node_getEntity(node)->forEachKeyValue([&](const std::string& key, const std::string&)
+		{
+			++numKeys;
+		});
+	}
+
+	std::size_t lookups = 0;
+	std::size_t valueLength = 0;
+	util::StopWatch lookupTimer;
+
+	for (int round = 0; round < rounds; ++round)
+	{
+		for (const auto& node : entityNodes)
+		{
+			auto entity = Node_getEntity(node);
+
+			// Query the keys of each entity as present, and in upper case
+			keys.clear();
+			entity->forEachKeyValue([&](const std::string& key, const std::string&)
+			{
+				keys.push_back(key);
+				keys.push_back(string::to_upper_copy(key));
+			});
+
+			for (const auto& key : keys)
+			{
+				valueLength += entity->getKeyValue(key).length();
+			}
+
+			for (auto key : COMMON_KEYS)
+			{
+				valueLength += entity->getKeyValue(key).length();
+			}
+
+			lookups += keys.size() + std::size(COMMON_KEYS);
+		}
+	}
+
+	auto lookupUsecs = lookupTimer.getMicroSecondsPassed();
+
+	std::size_t clones = 0;
+	util::StopWatch cloneTimer;
+
+	for (int round = 0; round < rounds; ++round)
+	{
+		for (const auto& node : entityNodes)
+		{
+			if (scene::cloneSingleNode(node))
+			{
+				++clones;
+			}
+		}
+	}
+
+	auto cloneUsecs = cloneTimer.getMicroSecondsPassed();
+
+	rMessage() << fmt::format("Entity key value benchmark ({0} entities, {1} spawnargs, {2} rounds)",
+		entityNodes.size(), numKeys, rounds) << std::endl
+		<< "  Key lookups:    " << formatRate(lookups, lookupUsecs) << " - " << lookups << " lookups" << std::endl
+		<< "  Entity clones:  " << formatRate(clones, cloneUsecs) << " - " << clones << " clones" << std::endl;
+
+	// Prevent the lookups from being optimised away
+	rDebug() << "  Total value length: " << valueLength << std::endl;
+}
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "icommandsystem.h"
+
+namespace entity
+{
+
+/**
+ * Command target measuring the spawnarg lookup and entity clone throughput
+ * on the entities of the currently loaded map. Takes an optional number of
+ * rounds (defaults to 10), the results are written to the console.
+ */
+void benchmarkEntityKeyValues(const cmd::ArgumentList& args);
+
+}
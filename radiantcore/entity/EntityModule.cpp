@@ -29,6 +29,7 @@
 #include "command/ExecutionFailure.h"
 #include "eclass.h"
 #include "algorithm/Speaker.h"
+#include "EntityBenchmark.h"
 
 namespace entity
 {
@@ -285,6 +286,8 @@ void Doom3EntityModule::initialiseModule(const IApplicationContext& ctx)
 
 	GlobalCommandSystem().addCommand("CreateSpeaker", std::bind(&algorithm::CreateSpeaker, std::placeholders::_1),
 		{ cmd::ARGTYPE_STRING, cmd::ARGTYPE_VECTOR3 });
+	GlobalCommandSystem().addCommand("BenchmarkEntityKeyValues", benchmarkEntityKeyValues,
+		{ cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL });
 
 	_settingsListener = EntitySettings::InstancePtr()->signal_settingsChanged().connect(
 		sigc::mem_fun(this, &Doom3EntityModule::onEntitySettingsChanged));
@@ -10,6 +10,7 @@
 #include "ishaders.h"
 
 #include "module/StaticModule.h"
+#include "debugging/ScopedDebugTimer.h"
 #include "InstanceUpdateWalker.h"
 #include "SetObjectSelectionByFilterWalker.h"
 
@@ -43,7 +44,7 @@ void BasicFilterSystem::setAllFilterStates(bool state)
 
 	// Invalidate the visibility cache to force new values to be
 	// loaded from the filters themselves
-	_visibilityCache.clear();
+	invalidateVisibilityCache();
 
 	// Update the scenegraph instances
 	update();
@@ -165,6 +166,8 @@ void BasicFilterSystem::initialiseModule(const IApplicationContext& ctx)
 	// user-defined filters
 	addFiltersFromXML(userFilters, false);
 
+	invalidateVisibilityCache();
+
 	// Add the (de-)activate all commands
 	GlobalCommandSystem().addCommand("SetAllFilterStates",
 		std::bind(&BasicFilterSystem::setAllFilterStatesCmd, this, std::placeholders::_1), { cmd::ARGTYPE_INT });
@@ -324,6 +327,8 @@ void BasicFilterSystem::shutdownModule()
 	}
 
 	_visibilityCache.clear();
+	_entityVisibilityCache.clear();
+	_activeEntityKeys.clear();
 	_eventAdapters.clear();
 	_activeFilters.clear();
 	_availableFilters.clear();
@@ -391,7 +396,7 @@ void BasicFilterSystem::setFilterState(const std::string& filter, bool state)
 
 	// Invalidate the visibility cache to force new values to be
 	// loaded from the filters themselves
-	_visibilityCache.clear();
+	invalidateVisibilityCache();
 
 	// Update the scenegraph instances
 	update();
@@ -462,7 +467,7 @@ bool BasicFilterSystem::removeFilter(const std::string& filter)
 	if (wasActive)
 	{
 		// Clear the cache, the rules have changed
-		_visibilityCache.clear();
+		invalidateVisibilityCache();
 
 		_filterConfigChangedSignal.emit();
 
@@ -569,8 +574,52 @@ bool BasicFilterSystem::isVisible(const FilterRule::Type type, const std::string
 	return visFlag;
 }
 
+void BasicFilterSystem::invalidateVisibilityCache()
+{
+	_visibilityCache.clear();
+	_entityVisibilityCache.clear();
+	_activeEntityKeys.clear();
+
+	for (const auto& active : _activeFilters)
+	{
+		active.second->foreachEntityKey([this](const std::string& key)
+		{
+			_activeEntityKeys.insert(key);
+		});
+	}
+}
+
+std::string BasicFilterSystem::getEntityCacheKey(FilterRule::Type type, const Entity& entity) const
+{
+	if (type == FilterRule::TYPE_ENTITYCLASS)
+	{
+		return "c" + entity.getEntityClass()->getDeclName();
+	}
+
+	// Spawnarg values can't contain null characters, use them as separator
+	std::string key(1, 'k');
+
+	for (const auto& entityKey : _activeEntityKeys)
+	{
+		key.append(entity.getKeyValue(entityKey));
+		key.push_back('\0');
+	}
+
+	return key;
+}
+
 bool BasicFilterSystem::isEntityVisible(const FilterRule::Type type, const Entity& entity)
 {
+	if (_activeFilters.empty()) return true;
+
+	auto cacheKey = getEntityCacheKey(type, entity);
+	auto cacheIter = _entityVisibilityCache.find(cacheKey);
+
+	if (cacheIter != _entityVisibilityCache.end())
+	{
+		return cacheIter->second;
+	}
+
 	// Otherwise, walk the list of active filters to find a value for
 	// this item.
 	bool visFlag = true; // default if no filters modify it
@@ -587,6 +636,8 @@ bool BasicFilterSystem::isEntityVisible(const FilterRule::Type type, const Entit
 		}
 	}
 
+	_entityVisibilityCache.emplace(std::move(cacheKey), visFlag);
+
 	return visFlag;
 }
 
@@ -607,7 +658,7 @@ bool BasicFilterSystem::setFilterRules(const std::string& filter, const FilterRu
 		f->second->setRules(ruleSet);
 
 		// Clear the cache, the ruleset has changed
-		_visibilityCache.clear();
+		invalidateVisibilityCache();
 
 		_filterConfigChangedSignal.emit();
 
@@ -634,6 +685,8 @@ void BasicFilterSystem::updateScene()
 
 	if (!rootNode) return;
 
+	ScopedDebugTimer timer("[filters] Updated scene");
+
 	// pass scenegraph root to specialised routine
 	updateSubgraph(rootNode);
 
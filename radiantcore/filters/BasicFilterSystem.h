@@ -5,6 +5,8 @@
 #include "icommandsystem.h"
 
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -34,6 +36,16 @@ private:
 	typedef std::map<std::string, bool> StringFlagCache;
 	StringFlagCache _visibilityCache;
 
+	// Cache of entity visibility flags. An entity's visibility only depends on
+	// its classname and the values of the keys referenced by the active filters,
+	// these are combined into the cache key. Since an entity changing its
+	// spawnargs results in a different cache key no per-entity invalidation is
+	// necessary, the cache is cleared along with the one above.
+	std::unordered_map<std::string, bool> _entityVisibilityCache;
+
+	// The keys referenced by the entitykeyvalue rules of the active filters
+	std::set<std::string> _activeEntityKeys;
+
 	sigc::signal<void> _filterConfigChangedSignal;
 	sigc::signal<void> _filterCollectionChangedSignal;
 
@@ -48,6 +60,11 @@ private:
 
 	void updateShaders();
 
+	// Clears the visibility caches, to be called when the active rules have changed
+	void invalidateVisibilityCache();
+
+	std::string getEntityCacheKey(FilterRule::Type type, const Entity& entity) const;
+
 	void addFiltersFromXML(const xml::NodeList& nodes, bool readOnly);
 
 	XmlFilterEventAdapter::Ptr ensureEventAdapter(XMLFilter& filter);
@@ -3,7 +3,7 @@
 #include "scene/Entity.h"
 #include "ieclass.h"
 #include "ifilter.h"
-#include <regex>
+#include "itextstream.h"
 #include <algorithm>
 
 namespace filters
@@ -16,6 +16,68 @@ XMLFilter::XMLFilter(const std::string& name, bool readOnly) :
 	updateEventName();
 }
 
+namespace
+{
+	// Characters with a special meaning in an ECMAScript regular expression
+	inline bool isLiteral(const std::string& expression)
+	{
+		return expression.find_first_of(".[]{}()*+?^$|\\") == std::string::npos;
+	}
+}
+
+bool XMLFilter::CompiledRule::matches(const std::string& name) const
+{
+	switch (matchType)
+	{
+	case MatchType::Literal:
+		return name == literal;
+	case MatchType::Prefix:
+		return name.compare(0, literal.length(), literal) == 0;
+	case MatchType::Regex:
+		return std::regex_match(name, regex);
+	default:
+		return false;
+	}
+}
+
+XMLFilter::CompiledRule XMLFilter::CompileRule(const FilterRule& rule)
+{
+	CompiledRule compiled;
+	const auto& match = rule.match;
+
+	if (isLiteral(match))
+	{
+		compiled.matchType = CompiledRule::MatchType::Literal;
+		compiled.literal = match;
+		return compiled;
+	}
+
+	for (const std::string suffix : { ".*", "(.*)" })
+	{
+		if (match.length() >= suffix.length() &&
+			match.compare(match.length() - suffix.length(), suffix.length(), suffix) == 0 &&
+			isLiteral(match.substr(0, match.length() - suffix.length())))
+		{
+			compiled.matchType = CompiledRule::MatchType::Prefix;
+			compiled.literal = match.substr(0, match.length() - suffix.length());
+			return compiled;
+		}
+	}
+
+	try
+	{
+		compiled.regex = std::regex(match);
+		compiled.matchType = CompiledRule::MatchType::Regex;
+	}
+	catch (const std::regex_error& ex)
+	{
+		rWarning() << "Invalid filter expression " << match << ": " << ex.what() << std::endl;
+		compiled.matchType = CompiledRule::MatchType::Invalid;
+	}
+
+	return compiled;
+}
+
 // Test visibility of an item against all rules
 bool XMLFilter::isVisible(const FilterRule::Type type, const std::string& name) const
 {
@@ -25,24 +87,18 @@ bool XMLFilter::isVisible(const FilterRule::Type type, const std::string& name)
 
 	bool visible = true; // default if unmodified by rules
 
-	for (FilterRules::const_iterator ruleIter = _rules.begin();
-		 ruleIter != _rules.end();
-		 ++ruleIter)
+	for (std::size_t i = 0; i < _rules.size(); ++i)
 	{
 		// Check the item type.
-		if (ruleIter->type != type)
+		if (_rules[i].type != type)
 		{
 			continue;
 		}
 
-		// If we have a rule for this item, use a regex to match the query name
-		// against the "match" parameter
-		std::regex ex(ruleIter->match);
-
-		if (std::regex_match(name, ex))
+		if (_compiledRules[i].matches(name))
 		{
 			// Overwrite the visible flag with the value from the rule.
-			visible = ruleIter->show;
+			visible = _rules[i].show;
 		}
 	}
 
@@ -56,31 +112,27 @@ bool XMLFilter::isEntityVisible(const FilterRule::Type type, const Entity& entit
 
 	IEntityClassConstPtr eclass = entity.getEntityClass();
 
-	for (FilterRules::const_iterator ruleIter = _rules.begin();
-		 ruleIter != _rules.end();
-		 ++ruleIter)
+	for (std::size_t i = 0; i < _rules.size(); ++i)
 	{
-		if (ruleIter->type != type)
+		const auto& rule = _rules[i];
+
+		if (rule.type != type)
 		{
 			continue;
 		}
 
 		if (type == FilterRule::TYPE_ENTITYCLASS)
 		{
-			std::regex ex(ruleIter->match);
-
-			if (std::regex_match(eclass->getDeclName(), ex))
+			if (_compiledRules[i].matches(eclass->getDeclName()))
 			{
-				visible = ruleIter->show;
+				visible = rule.show;
 			}
 		}
 		else if (type == FilterRule::TYPE_ENTITYKEYVALUE)
 		{
-			std::regex ex(ruleIter->match);
-
-			if (std::regex_match(entity.getKeyValue(ruleIter->entityKey), ex))
+			if (_compiledRules[i].matches(entity.getKeyValue(rule.entityKey)))
 			{
-				visible = ruleIter->show;
+				visible = rule.show;
 			}
 		}
 	}
@@ -88,6 +140,17 @@ bool XMLFilter::isEntityVisible(const FilterRule::Type type, const Entity& entit
 	return visible;
 }
 
+void XMLFilter::foreachEntityKey(const std::function<void(const std::string&)>& functor) const
+{
+	for (const auto& rule : _rules)
+	{
+		if (rule.type == FilterRule::TYPE_ENTITYKEYVALUE)
+		{
+			functor(rule.entityKey);
+		}
+	}
+}
+
 const std::string& XMLFilter::getEventName() const {
 	return _eventName;
 }
@@ -116,6 +179,14 @@ const FilterRules& XMLFilter::getRuleSet() const
 
 void XMLFilter::setRules(const FilterRules& rules) {
 	_rules = rules;
+
+	_compiledRules.clear();
+	_compiledRules.reserve(_rules.size());
+
+	for (const auto& rule : _rules)
+	{
+		_compiledRules.push_back(CompileRule(rule));
+	}
 }
 
 void XMLFilter::updateEventName() {
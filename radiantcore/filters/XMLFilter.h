@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
+#include <regex>
 #include "ifilter.h"
 
 namespace filters
@@ -24,6 +26,28 @@ private:
 	// Ordered list of rule objects
 	FilterRules _rules;
 
+	// A rule's match expression in a form which can be evaluated quickly.
+	// Plain names and prefixes (like "snd_.*") are compared without regex.
+	struct CompiledRule
+	{
+		enum class MatchType
+		{
+			Literal,	// the expression doesn't contain any special characters
+			Prefix,		// a literal followed by .* or (.*)
+			Regex,
+			Invalid,	// the expression failed to compile, never matches
+		};
+
+		MatchType matchType;
+		std::string literal;
+		std::regex regex;
+
+		bool matches(const std::string& name) const;
+	};
+
+	// Compiled expressions, in the same order as _rules
+	std::vector<CompiledRule> _compiledRules;
+
 	// True if this filter can't be changed
 	bool _readonly;
 
@@ -55,6 +79,7 @@ public:
 	void addRule(const FilterRule::Type type, const std::string& match, bool show)
 	{
 		_rules.push_back(FilterRule::Create(type, match, show));
+		_compiledRules.push_back(CompileRule(_rules.back()));
 	}
 
 	/** Add an entitykeyvalue rule to this filter.
@@ -72,6 +97,7 @@ public:
 	void addEntityKeyValueRule(const std::string& key, const std::string& match, bool show)
 	{
 		_rules.push_back(FilterRule::CreateEntityKeyValueRule(key, match, show));
+		_compiledRules.push_back(CompileRule(_rules.back()));
 	}
 
 	/** Test a given item for visibility against all of the rules
@@ -119,8 +145,13 @@ public:
 	// Applies the given ruleset, replacing the existing one.
 	void setRules(const FilterRules& rules);
 
+	// Invokes the functor with the key of every entitykeyvalue rule
+	void foreachEntityKey(const std::function<void(const std::string&)>& functor) const;
+
 private:
 	void updateEventName();
+
+	static CompiledRule CompileRule(const FilterRule& rule);
 };
 
 }
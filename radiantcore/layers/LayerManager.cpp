@@ -10,6 +10,7 @@
 #include "MoveToLayerWalker.h"
 #include "RemoveFromLayerWalker.h"
 #include "SetLayerSelectedWalker.h"
+#include "UpdateLayerVisibilityWalker.h"
 
 #include <functional>
 #include <climits>
@@ -59,7 +60,7 @@ int LayerManager::createLayer(const std::string& name, int layerID)
 	_layerParentIds.resize(highestID+1);
 
 	// Set the newly created layer to "visible"
-	_layerVisibility[layerID] = true;
+	setLayerVisibilityFlag(layerID, true);
 	_layerParentIds[layerID] = NO_PARENT_ID;
 
 	// Layers have changed
@@ -112,7 +113,7 @@ void LayerManager::deleteLayer(const std::string& name)
 	_layers.erase(layerID);
 
 	// Reset the visibility flag to TRUE, remove parent
-	_layerVisibility[layerID] = true;
+	setLayerVisibilityFlag(layerID, true);
 	_layerParentIds[layerID] = NO_PARENT_ID;
 
 	if (layerID == _activeLayer)
@@ -145,7 +146,8 @@ void LayerManager::reset()
 	_layers.emplace(DEFAULT_LAYER, _(DEFAULT_LAYER_NAME));
 
 	_layerVisibility.resize(1);
-	_layerVisibility[DEFAULT_LAYER] = true;
+	_visibleLayers.clear();
+	setLayerVisibilityFlag(DEFAULT_LAYER, true);
 
 	_layerParentIds.resize(1);
 	_layerParentIds[DEFAULT_LAYER] = NO_PARENT_ID;
@@ -224,7 +226,7 @@ bool LayerManager::layerIsVisible(int layerID)
 
 void LayerManager::setLayerVisibility(int layerId, bool visible)
 {
-	auto layerVisibilityChanged = setLayerVisibilityRecursively(layerId, visible);
+	auto changedLayers = setLayerVisibilityRecursively(layerId, visible);
 
 	if (!visible && !_layerVisibility.at(_activeLayer))
 	{
@@ -240,26 +242,44 @@ void LayerManager::setLayerVisibility(int layerId, bool visible)
 		_activeLayer = layerId;
 	}
 
-	if (layerVisibilityChanged)
+	if (!changedLayers.empty())
 	{
 		// Fire the visibility changed event
-		onLayerVisibilityChanged();
+		onLayerVisibilityChanged(changedLayers);
 	}
 }
 
-bool LayerManager::setLayerVisibilityRecursively(int rootLayerId, bool visible)
+LayerList LayerManager::setLayerVisibilityRecursively(int rootLayerId, bool visible)
 {
-	bool visibilityChange = false;
+	LayerList changedLayers;
 
 	foreachLayerInHierarchy(rootLayerId, [&](int layerId)
 	{
 		if (layerId < 0 || layerId >= _layerVisibility.size()) return;
 
-		visibilityChange |= _layerVisibility.at(layerId) != visible;
-		_layerVisibility.at(layerId) = visible;
+		if (_layerVisibility.at(layerId) != visible)
+		{
+			changedLayers.insert(layerId);
+		}
+
+		setLayerVisibilityFlag(layerId, visible);
 	});
 
-	return visibilityChange;
+	return changedLayers;
+}
+
+void LayerManager::setLayerVisibilityFlag(int layerId, bool visible)
+{
+	_layerVisibility.at(layerId) = visible;
+
+	if (visible)
+	{
+		_visibleLayers.insert(layerId);
+	}
+	else
+	{
+		_visibleLayers.erase(layerId);
+	}
 }
 
 void LayerManager::updateSceneGraphVisibility()
@@ -271,6 +291,15 @@ void LayerManager::updateSceneGraphVisibility()
 	SceneChangeNotify();
 }
 
+void LayerManager::updateSceneGraphVisibility(const LayerList& changedLayers)
+{
+	UpdateLayerVisibilityWalker walker(*this, changedLayers);
+	_rootNode.traverseChildren(walker);
+
+	// Redraw
+	SceneChangeNotify();
+}
+
 void LayerManager::onLayersChanged()
 {
 	_layersChangedSignal.emit();
@@ -283,10 +312,10 @@ void LayerManager::onNodeMembershipChanged()
 	updateSceneGraphVisibility();
 }
 
-void LayerManager::onLayerVisibilityChanged()
+void LayerManager::onLayerVisibilityChanged(const LayerList& changedLayers)
 {
-	// Update all nodes and views
-	updateSceneGraphVisibility();
+	// Update the affected nodes and views
+	updateSceneGraphVisibility(changedLayers);
 
 	// Update the UI
 	_layerVisibilityChangedSignal.emit();
@@ -335,23 +364,8 @@ bool LayerManager::updateNodeVisibility(const INodePtr& node)
 		return true; // doesn't support layers, return true for visible
 	}
 
-	// Get the list of layers the node is associated with
-	const auto& layers = node->getLayers();
-
-	// We start with the assumption that a node is hidden
-	bool isHidden = true;
-
-	// Cycle through the Node's layers, and show the node as soon as
-	// a visible layer is found.
-	for (int layerId : layers)
-	{
-		if (_layerVisibility[layerId])
-		{
-			// The layer is visible, set the visibility to true and quit
-			isHidden = false;
-			break;
-		}
-	}
+	// The node is visible if it is member of at least one visible layer
+	bool isHidden = !node->getLayers().intersects(_visibleLayers);
 
 	if (isHidden)
 	{
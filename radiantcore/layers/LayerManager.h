@@ -21,6 +21,10 @@ private:
 	// quickly check whether a layer is visible or not.
 	std::vector<bool> _layerVisibility;
 
+	// The IDs of all visible layers, kept in sync with _layerVisibility.
+	// Checking a node's layers against this list is a single AND for most nodes.
+	LayerList _visibleLayers;
+
 	// The parent IDs of each layer (-1 for no parent)
 	std::vector<int> _layerParentIds;
 
@@ -124,8 +128,11 @@ public:
 private:
 	// Recursively sets the visibility of the given layer and updates
 	// the flags on the _layerVisibility vector.
-	// Returns true if any flag changed, false if nothing changed.
-	bool setLayerVisibilityRecursively(int layerID, bool visible);
+	// Returns the IDs of the layers whose flag has been changed.
+	LayerList setLayerVisibilityRecursively(int layerID, bool visible);
+
+	// Sets the visibility flag of a single layer
+	void setLayerVisibilityFlag(int layerId, bool visible);
 
 	// Invokes the function object with each layer ID in the hierarchy, including the given root
 	void foreachLayerInHierarchy(int rootLayerId, const std::function<void(int)>& functor);
@@ -133,8 +140,8 @@ private:
 	// Internal event emitter
 	void onLayersChanged();
 
-	// Internal event, updates the scenegraph
-	void onLayerVisibilityChanged();
+	// Internal event, updates the nodes affected by the given layers
+	void onLayerVisibilityChanged(const LayerList& changedLayers);
 
 	// Internal event emitter
 	void onNodeMembershipChanged();
@@ -142,6 +149,9 @@ private:
 	// Updates the visibility state of the entire scenegraph
 	void updateSceneGraphVisibility();
 
+	// Updates the visibility state of the nodes which are members of the given layers
+	void updateSceneGraphVisibility(const LayerList& changedLayers);
+
 	// Returns the highest used layer Id
 	int getHighestLayerID() const;
 
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stack>
+#include "ilayer.h"
+#include "inode.h"
+#include "iselectable.h"
+
+namespace scene
+{
+
+/**
+ * Incremental variant of the UpdateNodeVisibilityWalker, to be used after the
+ * visibility of a few layers changed while the node memberships didn't.
+ *
+ * Leaf nodes which are not a member of any of the changed layers keep
+ * their current state. Nodes with children are always re-evaluated, since
+ * a parent is shown as soon as any of its children is visible.
+ */
+class UpdateLayerVisibilityWalker :
+	public NodeVisitor
+{
+private:
+	std::stack<bool> _visibilityStack;
+	ILayerManager& _layerManager;
+
+	// The layers whose visibility state has been changed
+	const LayerList& _changedLayers;
+
+public:
+	UpdateLayerVisibilityWalker(ILayerManager& layerManager, const LayerList& changedLayers) :
+		_layerManager(layerManager),
+		_changedLayers(changedLayers)
+	{}
+
+	bool pre(const INodePtr& node) override
+	{
+		if (isUnaffectedLeaf(node))
+		{
+			// Unaffected leaf, just report its visibility to the parent
+			_visibilityStack.push(!node->checkStateFlag(Node::eLayered));
+			return false;
+		}
+
+		_visibilityStack.push(_layerManager.updateNodeVisibility(node));
+		return true;
+	}
+
+	void post(const INodePtr& node) override
+	{
+		bool childIsVisible = _visibilityStack.top();
+		_visibilityStack.pop();
+
+		if (isUnaffectedLeaf(node))
+		{
+			// Unaffected leaf, no need to touch it
+			propagateVisibility(childIsVisible);
+			return;
+		}
+
+		if (childIsVisible)
+		{
+			// Show the node, regardless whether it was hidden before
+			// otherwise the parent would hide the visible children as well
+			node->disable(Node::eLayered);
+		}
+
+		if (node->checkStateFlag(Node::eLayered))
+		{
+			// Node is hidden by layers after update (and no children are visible), de-select
+			Node_setSelected(node, false);
+		}
+
+		propagateVisibility(childIsVisible);
+	}
+
+private:
+	bool isUnaffectedLeaf(const INodePtr& node) const
+	{
+		return !node->hasChildNodes() && node->supportsStateFlag(Node::eLayered) &&
+			!node->getLayers().intersects(_changedLayers);
+	}
+
+	void propagateVisibility(bool childIsVisible)
+	{
+		if (childIsVisible && !_visibilityStack.empty())
+		{
+			// The child was visible, set this parent to true
+			_visibilityStack.top() = true;
+		}
+	}
+};
+
+} // namespace
@@ -51,6 +51,9 @@
 #include "module/StaticModule.h"
 #include "command/ExecutionNotPossible.h"
 #include "MapPropertyInfoFileModule.h"
+#include "format/MapTokeniserBenchmark.h"
+#include "format/MapWriterBenchmark.h"
+#include "MapComparisonBenchmark.h"
 #include "messages/NotificationMessage.h"
 
 #include <fmt/format.h>
@@ -1033,6 +1036,10 @@ void Map::registerCommands()
 		  cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL, // replace selection with model
 		  cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL }); // export lights as objects
 
+	GlobalCommandSystem().addCommand("BenchmarkMapTokeniser", benchmarkMapTokeniser, { cmd::ARGTYPE_STRING | cmd::ARGTYPE_OPTIONAL });
+	GlobalCommandSystem().addCommand("BenchmarkMapComparison", benchmarkMapComparison, { cmd::ARGTYPE_STRING, cmd::ARGTYPE_STRING });
+	GlobalCommandSystem().addCommand("BenchmarkMapWriters", benchmarkMapWriters);
+
 	// Add undo commands
 	GlobalCommandSystem().addCommand("Undo", std::bind(&Map::undoCmd, this, std::placeholders::_1));
 	GlobalCommandSystem().addCommand("Redo", std::bind(&Map::redoCmd, this, std::placeholders::_1));
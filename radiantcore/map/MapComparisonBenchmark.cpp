@@ -0,0 +1,141 @@
+#include "MapComparisonBenchmark.h"
+
+#include <algorithm>
+#include <limits>
+#include <fmt/format.h>
+
+#include "imapresource.h"
+#include "itextstream.h"
+#include "os/file.h"
+#include "os/path.h"
+#include "scene/EntityNode.h"
+#include "scene/merge/GraphComparer.h"
+#include "scene/merge/NodeUtils.h"
+#include "time/StopWatch.h"
+
+namespace map
+{
+
+namespace
+{
+	constexpr std::size_t NUM_RUNS = 5;
+
+	struct NodeCount
+	{
+		std::size_t entities = 0;
+		std::size_t primitives = 0;
+	};
+
+	NodeCount countNodes(const scene::INodePtr& root)
+	{
+		NodeCount count;
+
+		root->foreachNode([&](const scene::INodePtr& entity)
+		{
+			++count.entities;
+
+			entity->foreachNode([&](const scene::INodePtr& primitive)
+			{
+				++count.primitives;
+				return true;
+			});
+
+			return true;
+		});
+
+		return count;
+	}
+
+	// Runs the given function a few times and returns the fastest run in msecs
+	template<typename Func>
+	double measureBestOf(const Func& func)
+	{
+		auto best = std::numeric_limits<std::size_t>::max();
+
+		for (std::size_t i = 0; i < NUM_RUNS; ++i)
+		{
+			util::StopWatch timer;
+			func();
+			best = std::min(best, timer.getMicroSecondsPassed());
+		}
+
+		return best / 1000.0;
+	}
+
+	IMapResourcePtr loadResource(const std::string& path)
+	{
+		auto resource = GlobalMapResourceManager().createFromPath(path);
+
+		try
+		{
+			if (resource->load())
+			{
+				return resource;
+			}
+		}
+		catch (const IMapResource::OperationException& ex)
+		{
+			rError() << "Failed to load " << path << ": " << ex.what() << std::endl;
+		}
+
+		return IMapResourcePtr();
+	}
+}
+
+void benchmarkMapComparison(const cmd::ArgumentList& args)
+{
+	if (args.size() != 2)
+	{
+		rWarning() << "Usage: BenchmarkMapComparison <source map path> <base map path>" << std::endl;
+		return;
+	}
+
+	auto sourcePath = os::standardPath(args[0].getString());
+	auto basePath = os::standardPath(args[1].getString());
+
+	if (!os::fileOrDirExists(sourcePath) || !os::fileOrDirExists(basePath))
+	{
+		rWarning() << "Cannot find the map files to compare" << std::endl;
+		return;
+	}
+
+	auto sourceResource = loadResource(sourcePath);
+	auto baseResource = loadResource(basePath);
+
+	if (!sourceResource || !baseResource) return;
+
+	const auto& source = sourceResource->getRootNode();
+	const auto& base = baseResource->getRootNode();
+
+	auto sourceCount = countNodes(source);
+	auto baseCount = countNodes(base);
+
+	std::size_t numFingerprints = 0;
+
+	auto fingerprintTime = measureBestOf([&]()
+	{
+		numFingerprints = scene::merge::NodeUtils::CollectEntityFingerprints(source).size() +
+			scene::merge::NodeUtils::CollectEntityFingerprints(base).size();
+	});
+
+	scene::merge::ComparisonResult::Ptr result;
+
+	auto compareTime = measureBestOf([&]()
+	{
+		result = scene::merge::GraphComparer::Compare(source, base);
+	});
+
+	rMessage() << "Map comparison benchmark (best of " << NUM_RUNS << " runs)" << std::endl
+		<< fmt::format("  Source: {0} ({1} entities, {2} primitives)",
+			os::getFilename(sourcePath), sourceCount.entities, sourceCount.primitives) << std::endl
+		<< fmt::format("  Base:   {0} ({1} entities, {2} primitives)",
+			os::getFilename(basePath), baseCount.entities, baseCount.primitives) << std::endl
+		<< fmt::format("  Entity fingerprints: {0:8.2f} ms ({1} fingerprints)", fingerprintTime, numFingerprints) << std::endl
+		<< fmt::format("  Graph comparison:    {0:8.2f} ms ({1} equivalent, {2} differing entities)",
+			compareTime, result->equivalentEntities.size(), result->differingEntities.size()) << std::endl;
+
+	sourceResource->clear();
+	baseResource->clear();
+}
+
+}
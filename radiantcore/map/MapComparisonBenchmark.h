@@ -0,0 +1,17 @@
+#pragma once
+
+#include "icommandsystem.h"
+
+namespace map
+{
+
+/**
+ * Command target measuring the time spent comparing two maps, as done
+ * when starting a merge operation. Takes the paths to the source and the
+ * base map, both are loaded into separate resources (not into the scene).
+ * The node fingerprinting and the full graph comparison are timed
+ * separately, the best of a few runs is written to the console.
+ */
+void benchmarkMapComparison(const cmd::ArgumentList& args);
+
+}
@@ -11,6 +11,7 @@
 #include "ifilesystem.h"
 #include "iregistry.h"
 #include "imapinfofile.h"
+#include "registry/registry.h"
 
 #include "map/RootNode.h"
 #include "imapfilechangetracker.h"
@@ -146,8 +147,20 @@ void MapResource::save(const MapFormatPtr& mapFormat)
 		throw OperationException(fmt::format(_("Map path is not absolute: {0}"), fullpath));
 	}
 
+	if (registry::getValue<bool>(RKEY_INCREMENTAL_MAP_SAVING))
+	{
+		if (!_exportCache)
+		{
+			_exportCache = std::make_shared<MapExportCache>();
+		}
+	}
+	else
+	{
+		_exportCache.reset();
+	}
+
 	// Save the actual file (throws on fail)
-	saveFile(*format, _mapRoot, scene::traverse, fullpath);
+	saveFile(*format, _mapRoot, scene::traverse, fullpath, _exportCache);
 
 	refreshLastModifiedTime();
 
@@ -241,6 +254,9 @@ void MapResource::setRootNode(const scene::IMapRootNodePtr& root)
 
 	_mapRoot = root;
 
+	// The cached text belongs to the nodes of the previous root
+	_exportCache.reset();
+
 	if (_mapRoot)
 	{
 		_mapChangeCountListener = _mapRoot->getUndoChangeTracker().signal_changed().connect(
@@ -403,7 +419,8 @@ void MapResource::throwIfNotWriteable(const fs::path& path)
 }
 
 void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr& root,
-						   const GraphTraversalFunc& traverse, const std::string& filename)
+						   const GraphTraversalFunc& traverse, const std::string& filename,
+						   const MapExportCache::Ptr& exportCache)
 {
 	// Actual output file paths
 	fs::path outFile = filename;
@@ -444,6 +461,24 @@ void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr
 
 	rMessage() << "success" << std::endl;
 
+	exportToStreams(format, root, traverse, outFileStream, auxFileStream.get(), exportCache);
+
+	// Check for any stream failures now that we're done writing
+	if (outFileStream.fail())
+	{
+		throw OperationException(fmt::format(_("Failure writing to file {0}"), outFile.string()));
+	}
+
+	if (auxFileStream && auxFileStream->fail())
+	{
+		throw OperationException(fmt::format(_("Failure writing to file {0}"), auxFile.string()));
+	}
+}
+
+void MapResource::exportToStreams(const MapFormat& format, const scene::IMapRootNodePtr& root,
+	const GraphTraversalFunc& traverse, std::ostream& mapStream, std::ostream* infoStream,
+	const MapExportCache::Ptr& exportCache)
+{
 	// Check the total count of nodes to traverse
 	NodeCounter counter;
 	traverse(root, counter);
@@ -455,15 +490,17 @@ void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr
 	MapExporterPtr exporter;
 	auto mapWriter = format.getMapWriter();
 
-	if (format.allowInfoFileCreation())
+	if (format.allowInfoFileCreation() && infoStream != nullptr)
 	{
-		exporter.reset(new MapExporter(*mapWriter, root, outFileStream, *auxFileStream, counter.getCount()));
+		exporter.reset(new MapExporter(*mapWriter, root, mapStream, *infoStream, counter.getCount()));
 	}
 	else
 	{
-		exporter.reset(new MapExporter(*mapWriter, root, outFileStream, counter.getCount())); // no aux stream
+		exporter.reset(new MapExporter(*mapWriter, root, mapStream, counter.getCount())); // no aux stream
 	}
 
+	exporter->setExportCache(exportCache);
+
 	try
 	{
 		// Pass the traversal function and the root of the subgraph to export
@@ -474,17 +511,6 @@ void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr
 	{
 		throw OperationException(_("Map writing cancelled"));
 	}
-
-	// Check for any stream failures now that we're done writing
-	if (outFileStream.fail())
-	{
-		throw OperationException(fmt::format(_("Failure writing to file {0}"), outFile.string()));
-	}
-
-	if (auxFileStream && auxFileStream->fail())
-	{
-		throw OperationException(fmt::format(_("Failure writing to file {0}"), auxFile.string()));
-	}
 }
 
 } // namespace map
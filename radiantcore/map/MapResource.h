@@ -8,6 +8,7 @@
 #include "RootNode.h"
 #include "os/fs.h"
 #include "stream/MapResourceStream.h"
+#include "algorithm/MapExportCache.h"
 #include <sigc++/connection.h>
 
 namespace map
@@ -41,6 +42,10 @@ private:
 	sigc::signal<void(bool)> _signalModifiedStatusChanged;
 	sigc::connection _mapChangeCountListener;
 
+	// The text written for each node during the last save, to only
+	// render the changed nodes on the next save of this resource
+	MapExportCache::Ptr _exportCache;
+
 public:
 	// Constructor
 	MapResource(const std::string& resourcePath);
@@ -62,9 +67,18 @@ public:
 	sigc::signal<void(bool)>& signal_modifiedStatusChanged() override;
 
 	// Save the map contents to the given filename using the given MapFormat export module
+	// The optional export cache is used to skip rendering the nodes unchanged since the last save.
 	// Throws an OperationException if anything prevents successful completion
 	static void saveFile(const MapFormat& format, const scene::IMapRootNodePtr& root,
-						 const GraphTraversalFunc& traverse, const std::string& filename);
+						 const GraphTraversalFunc& traverse, const std::string& filename,
+						 const MapExportCache::Ptr& exportCache = MapExportCache::Ptr());
+
+	// Export the map contents to the given streams using the given MapFormat export module.
+	// The info file stream is optional and only used if the format allows info file creation.
+	// Throws an OperationException if the export is cancelled
+	static void exportToStreams(const MapFormat& format, const scene::IMapRootNodePtr& root,
+		const GraphTraversalFunc& traverse, std::ostream& mapStream, std::ostream* infoStream,
+		const MapExportCache::Ptr& exportCache = MapExportCache::Ptr());
 
 protected:
 	// Implementation-specific method to open the stream of the primary .map or .mapx file
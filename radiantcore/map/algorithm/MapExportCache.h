@@ -0,0 +1,131 @@
+#pragma once
+
+#include <ios>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include "inode.h"
+#include "imapformat.h"
+
+namespace map
+{
+
+// Whether map saves reuse the text of the nodes unchanged since the previous save
+constexpr const char* const RKEY_INCREMENTAL_MAP_SAVING = "user/ui/map/incrementalSaving";
+
+/**
+ * Keeps the text the map writer produced for each entity and primitive
+ * during the previous save of a map, such that the next save only needs to
+ * render the nodes which have been changed since.
+ *
+ * A cached text is reused if the node's change stamp (see scene::Node::getChangeStamp)
+ * is the same and the node is written with the same writer counters as before.
+ * This only holds for writers supporting IMapWriter::createConcurrentWriter(),
+ * since their output is known to depend on nothing else.
+ *
+ * The cache is not thread-safe, but find() may be called from several threads
+ * as long as no other method is called at the same time.
+ */
+class MapExportCache
+{
+public:
+	using Ptr = std::shared_ptr<MapExportCache>;
+
+	struct Entry
+	{
+		unsigned long changeStamp;
+
+		// The writer counters the text has been rendered with
+		std::size_t entityCount;
+		std::size_t primitiveCount;
+
+		std::string text;
+	};
+
+private:
+	// The writer type and stream precision the texts have been rendered with
+	std::type_index _writerType;
+	std::streamsize _precision;
+
+	// The entries written by the previous save
+	std::unordered_map<const scene::INode*, Entry> _entries;
+
+	// The entries of the save in progress, nodes not visited
+	// by this save are dropped when the save is finished
+	std::unordered_map<const scene::INode*, Entry> _newEntries;
+
+public:
+	MapExportCache() :
+		_writerType(typeid(void)),
+		_precision(0)
+	{}
+
+	// Prepares the cache for a save, drops all entries if the writer type or precision changed
+	void beginSave(const IMapWriter& writer, std::streamsize precision)
+	{
+		// Entries of a cancelled save are still good
+		_entries.merge(_newEntries);
+		_newEntries.clear();
+
+		if (_writerType != std::type_index(typeid(writer)) || _precision != precision)
+		{
+			_entries.clear();
+			_writerType = typeid(writer);
+			_precision = precision;
+		}
+	}
+
+	// Replaces the entries of the previous save with the ones of the finished save
+	void finishSave()
+	{
+		_entries.swap(_newEntries);
+		_newEntries.clear();
+	}
+
+	// Returns the cached text of the given node, or nullptr if there is none matching the arguments
+	const std::string* find(const scene::INode* node, unsigned long changeStamp,
+		std::size_t entityCount, std::size_t primitiveCount) const
+	{
+		auto found = _entries.find(node);
+
+		if (found == _entries.end() || found->second.changeStamp != changeStamp ||
+			found->second.entityCount != entityCount || found->second.primitiveCount != primitiveCount)
+		{
+			return nullptr;
+		}
+
+		return &found->second.text;
+	}
+
+	// Moves the entry of the given node found by find() over to the save in progress
+	void keep(const scene::INode* node)
+	{
+		auto found = _entries.find(node);
+
+		if (found != _entries.end())
+		{
+			_newEntries.emplace(node, std::move(found->second));
+			_entries.erase(found);
+		}
+	}
+
+	// Stores the text rendered for the given node in the save in progress
+	void insert(const scene::INode* node, Entry&& entry)
+	{
+		_newEntries[node] = std::move(entry);
+	}
+
+	std::size_t size() const
+	{
+		return _entries.size();
+	}
+
+	void clear()
+	{
+		_entries.clear();
+		_newEntries.clear();
+	}
+};
+
+}
@@ -1,17 +1,20 @@
 #include "MapExporter.h"
 
 #include <ostream>
+#include <sstream>
 #include "i18n.h"
 #include "itextstream.h"
 #include "ibrush.h"
 #include "ipatch.h"
 #include "scene/EntityNode.h"
+#include "scene/Node.h"
 #include "imapresource.h"
 #include "imap.h"
 #include "igroupnode.h"
 
 #include "registry/registry.h"
 #include "string/string.h"
+#include "util/Parallel.h"
 
 #include "scene/ChildPrimitives.h"
 #include "messages/MapFileOperation.h"
@@ -23,6 +26,16 @@ namespace map
 	{
 		const char* const RKEY_FLOAT_PRECISION = "/mapFormat/floatPrecision";
 		const char* const RKEY_MAP_SAVE_STATUS_INTERLEAVE = "user/ui/map/saveStatusInterleave";
+		const char* const RKEY_PARALLEL_MAP_SAVING = "user/ui/map/parallelSaving";
+
+		// The number of nodes rendered in one go, limits the memory used for the text
+		constexpr std::size_t MAX_QUEUED_NODES = 16384;
+
+		// Small maps are written on the calling thread only
+		constexpr std::size_t MIN_NODES_PER_THREAD = 256;
+
+		// The number of nodes a thread claims at once
+		constexpr std::size_t NODES_PER_CHUNK = 64;
 	}
 
 MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root, std::ostream& mapStream, std::size_t nodeCount) :
@@ -34,7 +47,11 @@ MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
 	_curNodeCount(0),
 	_entityNum(0),
 	_primitiveNum(0),
-	_sendProgressMessages(true)
+	_sendProgressMessages(true),
+	_writeConcurrently(registry::getValue<bool>(RKEY_PARALLEL_MAP_SAVING)),
+	_queuedEntityCount(0),
+	_queuedPrimitiveCount(0),
+	_cachedNodeCount(0)
 {
 	construct();
 }
@@ -50,7 +67,11 @@ MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
 	_curNodeCount(0),
 	_entityNum(0),
 	_primitiveNum(0),
-	_sendProgressMessages(true)
+	_sendProgressMessages(true),
+	_writeConcurrently(registry::getValue<bool>(RKEY_PARALLEL_MAP_SAVING)),
+	_queuedEntityCount(0),
+	_queuedPrimitiveCount(0),
+	_cachedNodeCount(0)
 {
 	construct();
 }
@@ -110,9 +131,34 @@ void MapExporter::exportMap(const scene::INodePtr& root, const GraphTraversalFun
 		rError() << "Failure exporting a node (pre): " << ex.what() << std::endl;
 	}
 
+	// Writers not supporting it will write everything on this thread
+	_writeConcurrently = _writeConcurrently && _writer.createConcurrentWriter(0, 0);
+
+	// The cache is filled and used when writing the queued nodes
+	if (!_writeConcurrently)
+	{
+		_exportCache.reset();
+	}
+
+	if (_exportCache)
+	{
+		_exportCache->beginSave(_writer, _mapStream.precision());
+	}
+
 	// Perform the actual map traversal
 	traverse(root, *this);
 
+	// Write what's left in the queue
+	writeQueuedNodes();
+
+	if (_exportCache)
+	{
+		_exportCache->finishSave();
+
+		rMessage() << _cachedNodeCount << " of " << _exportCache->size() <<
+			" nodes have been unchanged since the last export" << std::endl;
+	}
+
 	try
 	{
 		auto mapRoot = std::dynamic_pointer_cast<scene::IMapRootNode>(root);
@@ -145,10 +191,17 @@ bool MapExporter::pre(const scene::INodePtr& node)
 
 		if (entity)
 		{
-			// Progress dialog handling
-			onNodeProgress();
-
-			_writer.beginWriteEntity(entity, _mapStream);
+			if (_writeConcurrently)
+			{
+				queueNode(QueuedNode::Type::BeginEntity, node);
+			}
+			else
+			{
+				// Progress dialog handling
+				onNodeProgress();
+
+				_writer.beginWriteEntity(entity, _mapStream);
+			}
 
 			if (_infoFileExporter) _infoFileExporter->visitEntity(node, _entityNum);
 
@@ -159,10 +212,17 @@ bool MapExporter::pre(const scene::INodePtr& node)
 
 		if (brush && brush->getIBrush().hasContributingFaces())
 		{
-			// Progress dialog handling
-			onNodeProgress();
-
-			_writer.beginWriteBrush(brush, _mapStream);
+			if (_writeConcurrently)
+			{
+				queueNode(QueuedNode::Type::Brush, node);
+			}
+			else
+			{
+				// Progress dialog handling
+				onNodeProgress();
+
+				_writer.beginWriteBrush(brush, _mapStream);
+			}
 
 			if (_infoFileExporter) _infoFileExporter->visitPrimitive(node, _entityNum, _primitiveNum);
 
@@ -173,10 +233,17 @@ bool MapExporter::pre(const scene::INodePtr& node)
 
 		if (patch)
 		{
-			// Progress dialog handling
-			onNodeProgress();
-
-			_writer.beginWritePatch(patch, _mapStream);
+			if (_writeConcurrently)
+			{
+				queueNode(QueuedNode::Type::Patch, node);
+			}
+			else
+			{
+				// Progress dialog handling
+				onNodeProgress();
+
+				_writer.beginWritePatch(patch, _mapStream);
+			}
 
 			if (_infoFileExporter) _infoFileExporter->visitPrimitive(node, _entityNum, _primitiveNum);
 
@@ -199,17 +266,30 @@ void MapExporter::post(const scene::INodePtr& node)
 
 		if (entity)
 		{
-			_writer.endWriteEntity(entity, _mapStream);
+			if (_writeConcurrently)
+			{
+				queueNode(QueuedNode::Type::EndEntity, node);
+			}
+			else
+			{
+				_writer.endWriteEntity(entity, _mapStream);
+			}
 
 			_entityNum++;
 			return;
 		}
 
+		// Queued primitives are written in one go, including the end call
+
 		auto brush = std::dynamic_pointer_cast<IBrushNode>(node);
 
 		if (brush && brush->getIBrush().hasContributingFaces())
 		{
-			_writer.endWriteBrush(brush, _mapStream);
+			if (!_writeConcurrently)
+			{
+				_writer.endWriteBrush(brush, _mapStream);
+			}
+
 			_primitiveNum++;
 			return;
 		}
@@ -218,7 +298,11 @@ void MapExporter::post(const scene::INodePtr& node)
 
 		if (patch)
 		{
-			_writer.endWritePatch(patch, _mapStream);
+			if (!_writeConcurrently)
+			{
+				_writer.endWritePatch(patch, _mapStream);
+			}
+
 			_primitiveNum++;
 			return;
 		}
@@ -250,6 +334,205 @@ void MapExporter::onNodeProgress()
 	}
 }
 
+void MapExporter::queueNode(QueuedNode::Type type, const scene::INodePtr& node)
+{
+	unsigned long changeStamp = 0;
+
+	if (_exportCache)
+	{
+		auto sceneNode = dynamic_cast<scene::Node*>(node.get());
+		changeStamp = sceneNode ? sceneNode->getChangeStamp() : 0;
+	}
+
+	_queuedNodes.emplace_back(QueuedNode{ type, node, _queuedEntityCount, _queuedPrimitiveCount, changeStamp });
+
+	// Keep track of the counters the writer will have after this node
+	switch (type)
+	{
+	case QueuedNode::Type::BeginEntity:
+		_queuedEntityCount++;
+		break;
+	case QueuedNode::Type::EndEntity:
+		_queuedPrimitiveCount = 0;
+		break;
+	default:
+		_queuedPrimitiveCount++;
+		break;
+	}
+
+	if (_queuedNodes.size() >= MAX_QUEUED_NODES)
+	{
+		writeQueuedNodes();
+	}
+}
+
+void MapExporter::writeQueuedNodes()
+{
+	if (_queuedNodes.empty()) return;
+
+	auto numChunks = (_queuedNodes.size() + NODES_PER_CHUNK - 1) / NODES_PER_CHUNK;
+	auto numThreads = util::getParallelThreadCount(_queuedNodes.size(), MIN_NODES_PER_THREAD);
+	auto precision = _mapStream.precision();
+
+	std::vector<std::string> chunkTexts(numChunks);
+
+	// Where the text of each node ended up, to fill the export cache
+	struct NodeText
+	{
+		std::size_t chunk;
+		std::size_t begin;
+		std::size_t end;
+		bool cached;
+		bool written;
+	};
+
+	std::vector<NodeText> nodeTexts(_exportCache ? _queuedNodes.size() : 0);
+
+	util::processChunksInParallel(_queuedNodes.size(), numChunks, numThreads,
+		[&](std::size_t chunk, std::size_t begin, std::size_t end)
+	{
+		IMapWriterPtr writer;
+
+		std::ostringstream stream;
+		stream.precision(precision);
+
+		for (auto i = begin; i < end; ++i)
+		{
+			const auto& queuedNode = _queuedNodes[i];
+
+			if (!_exportCache)
+			{
+				if (!writer)
+				{
+					writer = _writer.createConcurrentWriter(queuedNode.entityCount, queuedNode.primitiveCount);
+				}
+
+				writeQueuedNode(*writer, queuedNode, stream);
+				continue;
+			}
+
+			auto& nodeText = nodeTexts[i];
+			nodeText.chunk = chunk;
+			nodeText.begin = static_cast<std::size_t>(stream.tellp());
+
+			// The closing text of the entities is not worth caching
+			auto cachedText = queuedNode.type == QueuedNode::Type::EndEntity ? nullptr :
+				_exportCache->find(queuedNode.node.get(), queuedNode.changeStamp,
+					queuedNode.entityCount, queuedNode.primitiveCount);
+
+			if (cachedText)
+			{
+				stream.write(cachedText->data(), cachedText->size());
+				nodeText.cached = true;
+
+				// The writer counters didn't advance, it needs to be re-created
+				writer.reset();
+			}
+			else
+			{
+				if (!writer)
+				{
+					writer = _writer.createConcurrentWriter(queuedNode.entityCount, queuedNode.primitiveCount);
+				}
+
+				nodeText.written = writeQueuedNode(*writer, queuedNode, stream);
+			}
+
+			nodeText.end = static_cast<std::size_t>(stream.tellp());
+		}
+
+		chunkTexts[chunk] = stream.str();
+	});
+
+	// Append the text in the original node order
+	for (const auto& text : chunkTexts)
+	{
+		_mapStream.write(text.data(), text.size());
+	}
+
+	for (std::size_t i = 0; i < nodeTexts.size(); ++i)
+	{
+		const auto& queuedNode = _queuedNodes[i];
+		const auto& nodeText = nodeTexts[i];
+
+		if (nodeText.cached)
+		{
+			_exportCache->keep(queuedNode.node.get());
+			_cachedNodeCount++;
+		}
+		else if (nodeText.written && queuedNode.changeStamp != 0 && queuedNode.type != QueuedNode::Type::EndEntity)
+		{
+			_exportCache->insert(queuedNode.node.get(), MapExportCache::Entry
+			{
+				queuedNode.changeStamp, queuedNode.entityCount, queuedNode.primitiveCount,
+				chunkTexts[nodeText.chunk].substr(nodeText.begin, nodeText.end - nodeText.begin)
+			});
+		}
+	}
+
+	for (const auto& queuedNode : _queuedNodes)
+	{
+		if (queuedNode.type != QueuedNode::Type::EndEntity)
+		{
+			onNodeProgress();
+		}
+	}
+
+	_queuedNodes.clear();
+}
+
+bool MapExporter::writeQueuedNode(IMapWriter& writer, const QueuedNode& queuedNode, std::ostream& stream)
+{
+	try
+	{
+		switch (queuedNode.type)
+		{
+		case QueuedNode::Type::BeginEntity:
+			writer.beginWriteEntity(std::dynamic_pointer_cast<EntityNode>(queuedNode.node), stream);
+			break;
+		case QueuedNode::Type::EndEntity:
+			writer.endWriteEntity(std::dynamic_pointer_cast<EntityNode>(queuedNode.node), stream);
+			break;
+		case QueuedNode::Type::Brush:
+		{
+			auto brush = std::dynamic_pointer_cast<IBrushNode>(queuedNode.node);
+			writer.beginWriteBrush(brush, stream);
+			writer.endWriteBrush(brush, stream);
+			break;
+		}
+		case QueuedNode::Type::Patch:
+		{
+			auto patch = std::dynamic_pointer_cast<IPatchNode>(queuedNode.node);
+			writer.beginWritePatch(patch, stream);
+			writer.endWritePatch(patch, stream);
+			break;
+		}
+		}
+	}
+	catch (IMapWriter::FailureException& ex)
+	{
+		rError() << "Failure exporting a node: " << ex.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void MapExporter::enableConcurrentWriting()
+{
+	_writeConcurrently = true;
+}
+
+void MapExporter::disableConcurrentWriting()
+{
+	_writeConcurrently = false;
+}
+
+void MapExporter::setExportCache(const MapExportCache::Ptr& cache)
+{
+	_exportCache = cache;
+}
+
 void MapExporter::enableProgressMessages()
 {
 	_sendProgressMessages = true;
@@ -8,8 +8,10 @@
 
 #include "../infofile/InfoFileExporter.h"
 #include "EventRateLimiter.h"
+#include "MapExportCache.h"
 
 #include <sigc++/signal.h>
+#include <vector>
 
 namespace map
 {
@@ -55,6 +57,43 @@ private:
 
 	bool _sendProgressMessages;
 
+	// Whether nodes should be written on worker threads, if the writer supports it
+	bool _writeConcurrently;
+
+	// A node visited during traversal, to be written on a worker thread
+	struct QueuedNode
+	{
+		enum class Type
+		{
+			BeginEntity,
+			EndEntity,
+			Brush,
+			Patch,
+		};
+
+		Type type;
+		scene::INodePtr node;
+
+		// The writer counters before this node, see IMapWriter::createConcurrentWriter
+		std::size_t entityCount;
+		std::size_t primitiveCount;
+
+		// The change stamp of the node, only set if there is an export cache
+		unsigned long changeStamp;
+	};
+
+	std::vector<QueuedNode> _queuedNodes;
+
+	// The writer counters after the last queued node
+	std::size_t _queuedEntityCount;
+	std::size_t _queuedPrimitiveCount;
+
+	// Optional cache of the text written for each node during the previous export
+	MapExportCache::Ptr _exportCache;
+
+	// The number of nodes whose text has been taken from the export cache
+	std::size_t _cachedNodeCount;
+
 public:
 	// The constructor prepares the scene and the output stream
 	MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
@@ -80,12 +119,31 @@ public:
 	// Don't send any progress messages through the MessageBus while exporting
 	void disableProgressMessages();
 
+	// Write the nodes on worker threads, if supported by the map writer.
+	// The default is taken from the registry.
+	void enableConcurrentWriting();
+
+	// Write all nodes on the calling thread
+	void disableConcurrentWriting();
+
+	// Reuse the text of the nodes which didn't change since the given cache has been filled,
+	// and store the text of all written nodes in it. This needs concurrent writing to be enabled.
+	void setExportCache(const MapExportCache::Ptr& cache);
+
 private:
 	// Common code shared by the constructors
 	void construct();
 
 	void onNodeProgress();
 
+	void queueNode(QueuedNode::Type type, const scene::INodePtr& node);
+
+	// Renders the queued nodes on worker threads and writes the text to the map stream
+	void writeQueuedNodes();
+
+	// Returns false if the writer failed to write the node
+	bool writeQueuedNode(IMapWriter& writer, const QueuedNode& queuedNode, std::ostream& stream);
+
 	// Is called before exporting the scene to prepare func_* groups.
 	void prepareScene();
 
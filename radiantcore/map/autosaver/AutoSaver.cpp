@@ -3,7 +3,10 @@
 #include "i18n.h"
 #include <numeric>
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include "imapfilechangetracker.h"
+#include "imapresource.h"
 #include "itextstream.h"
 #include "iscenegraph.h"
 #include "iradiant.h"
@@ -27,6 +30,9 @@
 #include "messages/NotificationMessage.h"
 #include "messages/AutomaticMapSaveRequest.h"
 #include "map/Map.h"
+#include "map/MapResource.h"
+#include "scene/Traverse.h"
+#include "time/StopWatch.h"
 
 #include <fmt/format.h>
 
@@ -38,10 +44,9 @@ namespace
 	// Registry key names
 	const char* GKEY_MAP_EXTENSION = "/mapFormat/fileExtension";
 
-	std::string constructSnapshotName(const fs::path& snapshotPath, const std::string& mapName, int num)
+	std::string constructSnapshotName(const fs::path& snapshotPath, const std::string& mapName,
+		const std::string& mapExt, int num)
 	{
-		std::string mapExt = game::current::getValue<std::string>(GKEY_MAP_EXTENSION);
-
 		// Construct the base name without numbered extension
 		std::string filename = (snapshotPath / mapName).replace_extension().string();
 
@@ -57,12 +62,14 @@ namespace
 
 AutoMapSaver::AutoMapSaver() :
 	_snapshotsEnabled(false),
+	_saveInBackground(false),
 	_savedChangeCount(0)
 {}
 
 void AutoMapSaver::registryKeyChanged()
 {
 	_snapshotsEnabled = registry::getValue<bool>(RKEY_AUTOSAVE_SNAPSHOTS_ENABLED);
+	_saveInBackground = registry::getValue<bool>(RKEY_AUTOSAVE_IN_BACKGROUND);
 }
 
 void AutoMapSaver::clearChanges()
@@ -97,42 +104,207 @@ void AutoMapSaver::saveSnapshot()
 	auto mapName = fullPath.filename().string();
 
 	// Check if the folder exists and create it if necessary
-	if (os::fileOrDirExists(snapshotPath.string()) || os::makeDirectory(snapshotPath.string()))
+	if (!os::fileOrDirExists(snapshotPath.string()) && !os::makeDirectory(snapshotPath.string()))
+	{
+		rError() << "Snapshot save failed, unable to create directory " << snapshotPath << std::endl;
+		return;
+	}
+
+	auto mapExtension = game::current::getValue<std::string>(GKEY_MAP_EXTENSION);
+
+	if (!_saveInBackground)
 	{
 		// Map existing snapshots (snapshot num => path)
 		std::map<int, std::string> existingSnapshots;
 
-		collectExistingSnapshots(existingSnapshots, snapshotPath, mapName);
+		collectExistingSnapshots(existingSnapshots, snapshotPath, mapName, mapExtension);
 
 		int highestNum = existingSnapshots.empty() ? 0 : existingSnapshots.rbegin()->first + 1;
 
-		std::string filename = constructSnapshotName(snapshotPath, mapName, highestNum);
+		std::string filename = constructSnapshotName(snapshotPath, mapName, mapExtension, highestNum);
 
 		rMessage() << "Autosaving snapshot to " << filename << std::endl;
 
 		// Dump to map to the next available filename
 		GlobalCommandSystem().executeCommand("SaveAutomaticBackup", filename);
 
-		handleSnapshotSizeLimit(existingSnapshots, snapshotPath, mapName);
+		handleSnapshotSizeLimit(getSnapshotFolderSize(existingSnapshots), snapshotPath, mapName);
+		return;
+	}
+
+	// The previous snapshot needs to be completed before the next number can be determined
+	finishBackgroundSave();
+
+	BackupData data;
+
+	try
+	{
+		data = serialiseMap(constructSnapshotName(snapshotPath, mapName, mapExtension, 0));
+	}
+	catch (const IMapResource::OperationException& ex)
+	{
+		radiant::NotificationMessage::SendError(ex.what());
+		return;
+	}
+
+	auto infoFileExtension = game::current::getInfoFileExtension();
+
+	// Finding the snapshot number, writing the file and summing up the folder size
+	// are all done by the worker thread
+	_backgroundSave = std::async(std::launch::async,
+		[data = std::move(data), snapshotPath, mapName, mapExtension, infoFileExtension]()
+	{
+		std::map<int, std::string> existingSnapshots;
+
+		collectExistingSnapshots(existingSnapshots, snapshotPath, mapName, mapExtension);
+
+		int highestNum = existingSnapshots.empty() ? 0 : existingSnapshots.rbegin()->first + 1;
+
+		std::string filename = constructSnapshotName(snapshotPath, mapName, mapExtension, highestNum);
+
+		rMessage() << "Autosaving snapshot to " << filename << " in the background" << std::endl;
+
+		BackgroundSaveResult result;
+		result.error = writeBackup(data, filename, infoFileExtension);
+
+		if (result.error.empty())
+		{
+			result.isSnapshot = true;
+			result.folderSize = getSnapshotFolderSize(existingSnapshots);
+			result.snapshotPath = snapshotPath;
+			result.mapName = mapName;
+		}
+
+		return result;
+	});
+}
+
+void AutoMapSaver::saveBackup(const std::string& filename)
+{
+	if (!_saveInBackground)
+	{
+		// Invoke the save call
+		GlobalCommandSystem().executeCommand("SaveAutomaticBackup", filename);
+		return;
+	}
+
+	// Don't let two threads write the same file
+	finishBackgroundSave();
+
+	BackupData data;
+
+	try
+	{
+		data = serialiseMap(filename);
+	}
+	catch (const IMapResource::OperationException& ex)
+	{
+		radiant::NotificationMessage::SendError(ex.what());
+		return;
+	}
+
+	auto infoFileExtension = game::current::getInfoFileExtension();
+
+	_backgroundSave = std::async(std::launch::async, [data = std::move(data), filename, infoFileExtension]()
+	{
+		BackgroundSaveResult result;
+		result.error = writeBackup(data, filename, infoFileExtension);
+
+		return result;
+	});
+}
+
+AutoMapSaver::BackupData AutoMapSaver::serialiseMap(const std::string& filename)
+{
+	auto format = GlobalMap().getMapFormatForFilenameSafe(filename);
+
+	util::StopWatch timer;
+
+	if (registry::getValue<bool>(RKEY_INCREMENTAL_MAP_SAVING))
+	{
+		if (!_exportCache)
+		{
+			_exportCache = std::make_shared<MapExportCache>();
+		}
 	}
 	else
 	{
-		rError() << "Snapshot save failed, unable to create directory " << snapshotPath << std::endl;
+		_exportCache.reset();
 	}
+
+	std::ostringstream mapStream;
+	std::ostringstream infoStream;
+
+	// Only the nodes changed since the previous autosave need to be exported again
+	MapResource::exportToStreams(*format, GlobalSceneGraph().root(), scene::traverse, mapStream,
+		format->allowInfoFileCreation() ? &infoStream : nullptr, _exportCache);
+
+	BackupData data;
+	data.mapData = mapStream.str();
+	data.infoData = infoStream.str();
+	data.hasInfoFile = format->allowInfoFileCreation();
+
+	rMessage() << "Serialised map for autosave in " << timer.getMilliSecondsPassed() << " msec" << std::endl;
+
+	return data;
 }
 
-void AutoMapSaver::handleSnapshotSizeLimit(const std::map<int, std::string>& existingSnapshots,
-	const fs::path& snapshotPath, const std::string& mapName)
+std::string AutoMapSaver::writeBackup(const BackupData& data, const std::string& filename, const std::string& infoFileExtension)
 {
-	std::size_t maxSnapshotFolderSize =
-		registry::getValue<std::size_t>(RKEY_AUTOSAVE_MAX_SNAPSHOT_FOLDER_SIZE);
+	util::StopWatch timer;
 
-	// Sanity check in case there is something weird going on in the registry
-	if (maxSnapshotFolderSize == 0)
+	fs::path infoFile = filename;
+	infoFile.replace_extension(infoFileExtension);
+
+	// Same open mode as MapResource::saveFile, such that line endings match a regular save
+	std::ofstream mapStream(filename);
+	mapStream.write(data.mapData.data(), data.mapData.size());
+	mapStream.close();
+
+	if (mapStream.fail())
 	{
-		maxSnapshotFolderSize = 100;
+		rError() << "Failure writing to file " << filename << std::endl;
+		return fmt::format(_("Failure writing to file {0}"), filename);
+	}
+
+	if (data.hasInfoFile)
+	{
+		std::ofstream infoStream(infoFile.string());
+		infoStream.write(data.infoData.data(), data.infoData.size());
+		infoStream.close();
+
+		if (infoStream.fail())
+		{
+			rError() << "Failure writing to file " << infoFile.string() << std::endl;
+			return fmt::format(_("Failure writing to file {0}"), infoFile.string());
+		}
+	}
+
+	rMessage() << "Autosave written to " << filename << " in " << timer.getMilliSecondsPassed() << " msec" << std::endl;
+
+	return std::string();
+}
+
+void AutoMapSaver::finishBackgroundSave()
+{
+	if (!_backgroundSave.valid()) return;
+
+	auto result = _backgroundSave.get();
+
+	// The notifications are handled by the UI, which is why they are sent from here
+	if (!result.error.empty())
+	{
+		radiant::NotificationMessage::SendError(result.error);
 	}
 
+	if (result.isSnapshot)
+	{
+		handleSnapshotSizeLimit(result.folderSize, result.snapshotPath, result.mapName);
+	}
+}
+
+std::size_t AutoMapSaver::getSnapshotFolderSize(const std::map<int, std::string>& existingSnapshots)
+{
 	// Sum up the total folder size
 	std::size_t folderSize = 0;
 
@@ -141,6 +313,20 @@ void AutoMapSaver::handleSnapshotSizeLimit(const std::map<int, std::string>& exi
 		folderSize += os::getFileSize(pair.second);
 	}
 
+	return folderSize;
+}
+
+void AutoMapSaver::handleSnapshotSizeLimit(std::size_t folderSize, const fs::path& snapshotPath, const std::string& mapName)
+{
+	std::size_t maxSnapshotFolderSize =
+		registry::getValue<std::size_t>(RKEY_AUTOSAVE_MAX_SNAPSHOT_FOLDER_SIZE);
+
+	// Sanity check in case there is something weird going on in the registry
+	if (maxSnapshotFolderSize == 0)
+	{
+		maxSnapshotFolderSize = 100;
+	}
+
 	std::size_t maxSize = maxSnapshotFolderSize * 1024 * 1024;
 
 	// The key containing the previously calculated size
@@ -182,12 +368,12 @@ void AutoMapSaver::handleSnapshotSizeLimit(const std::map<int, std::string>& exi
 }
 
 void AutoMapSaver::collectExistingSnapshots(std::map<int, std::string>& existingSnapshots,
-	const fs::path& snapshotPath, const std::string& mapName)
+	const fs::path& snapshotPath, const std::string& mapName, const std::string& mapExtension)
 {
 	for (int num = 0; num < INT_MAX; num++)
 	{
 		// Construct the base name without numbered extension
-		std::string filename = constructSnapshotName(snapshotPath, mapName, num);
+		std::string filename = constructSnapshotName(snapshotPath, mapName, mapExtension, num);
 
 		if (!os::fileOrDirExists(filename))
 		{
@@ -200,6 +386,12 @@ void AutoMapSaver::collectExistingSnapshots(std::map<int, std::string>& existing
 
 bool AutoMapSaver::runAutosaveCheck()
 {
+	// Process the outcome of the previous background save, if it is done
+	if (_backgroundSave.valid() && _backgroundSave.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		finishBackgroundSave();
+	}
+
 	// Check, if changes have been made since the last autosave
 	if (!GlobalSceneGraph().root() || _savedChangeCount == GlobalSceneGraph().root()->getUndoChangeTracker().getCurrentChangeCount())
 	{
@@ -251,8 +443,7 @@ void AutoMapSaver::performAutosave()
 
 			rMessage() << "Autosaving unnamed map to " << autoSaveFilename << std::endl;
 
-			// Invoke the save call
-			GlobalCommandSystem().executeCommand("SaveAutomaticBackup", autoSaveFilename);
+			saveBackup(autoSaveFilename);
 		}
 		else
 		{
@@ -267,8 +458,7 @@ void AutoMapSaver::performAutosave()
 
 			rMessage() << "Autosaving map to " << filename << std::endl;
 
-			// Invoke the save call
-			GlobalCommandSystem().executeCommand("SaveAutomaticBackup", filename);
+			saveBackup(filename);
 		}
 	}
 }
@@ -279,6 +469,7 @@ void AutoMapSaver::constructPreferences()
 	IPreferencePage& page = GlobalPreferenceSystem().getPage(_("Autosave"));
 
 	page.appendCheckBox(_("Save Snapshots"), RKEY_AUTOSAVE_SNAPSHOTS_ENABLED);
+	page.appendCheckBox(_("Write files in the background"), RKEY_AUTOSAVE_IN_BACKGROUND);
 	page.appendEntry(_("Snapshot Folder (absolute, or relative to Map Folder)"), RKEY_AUTOSAVE_SNAPSHOTS_FOLDER);
 	page.appendEntry(_("Max total Snapshot size per Map (MB)"), RKEY_AUTOSAVE_MAX_SNAPSHOT_FOLDER_SIZE);
 }
@@ -294,6 +485,11 @@ void AutoMapSaver::onMapEvent(IMap::MapEvent ev)
 	case IMap::MapUnloading:
 	case IMap::MapUnloaded:
 		clearChanges();
+		// The cached texts refer to the nodes of the previous map
+		if (_exportCache)
+		{
+			_exportCache->clear();
+		}
 		break;
 	default:
 		break;
@@ -325,6 +521,9 @@ void AutoMapSaver::initialiseModule(const IApplicationContext& ctx)
 	_signalConnections.push_back(GlobalRegistry().signalForKey(RKEY_AUTOSAVE_SNAPSHOTS_ENABLED).connect(
 		sigc::mem_fun(this, &AutoMapSaver::registryKeyChanged)
 	));
+	_signalConnections.push_back(GlobalRegistry().signalForKey(RKEY_AUTOSAVE_IN_BACKGROUND).connect(
+		sigc::mem_fun(this, &AutoMapSaver::registryKeyChanged)
+	));
 
 	// Get notified when the map is loaded afresh
 	_signalConnections.push_back(GlobalMapModule().signal_mapEvent().connect(
@@ -343,6 +542,12 @@ void AutoMapSaver::initialiseModule(const IApplicationContext& ctx)
 
 void AutoMapSaver::shutdownModule()
 {
+	// Don't leave a half-written file behind
+	if (_backgroundSave.valid())
+	{
+		_backgroundSave.wait();
+	}
+
 	// Unsubscribe from all connections
 	for (sigc::connection& connection : _signalConnections)
 	{
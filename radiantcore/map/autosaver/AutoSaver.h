@@ -6,8 +6,10 @@
 #include "iautosaver.h"
 
 #include <vector>
+#include <future>
 #include <sigc++/connection.h>
 #include "os/fs.h"
+#include "map/algorithm/MapExportCache.h"
 
 namespace map
 {
@@ -23,10 +25,40 @@ private:
 	// TRUE, if the autosaver generates snapshots
 	bool _snapshotsEnabled;
 
+	// TRUE, if the files should be written on a worker thread
+	bool _saveInBackground;
+
 	std::size_t _savedChangeCount;
 
 	std::vector<sigc::connection> _signalConnections;
 
+	// The map and info file contents, serialised on the main thread
+	struct BackupData
+	{
+		std::string mapData;
+		std::string infoData;
+		bool hasInfoFile = false;
+	};
+
+	// Outcome of a background save. The size limit handling needs the registry
+	// and the UI, which is why it is processed on the main thread.
+	struct BackgroundSaveResult
+	{
+		std::string error;
+
+		// Only set for snapshots
+		bool isSnapshot = false;
+		std::size_t folderSize = 0;
+		fs::path snapshotPath;
+		std::string mapName;
+	};
+
+	std::future<BackgroundSaveResult> _backgroundSave;
+
+	// Keeps the text of the nodes written by the previous background save,
+	// such that the next one only needs to export the changed ones
+	MapExportCache::Ptr _exportCache;
+
 public:
 	// Constructor
 	AutoMapSaver();
@@ -56,11 +88,28 @@ private:
 	// Saves a snapshot of the currently active map (only named maps)
 	void saveSnapshot();
 
-	void collectExistingSnapshots(std::map<int, std::string>& existingSnapshots,
-		const fs::path& snapshotPath, const std::string& mapName);
+	// Saves the currently active map to the given file
+	void saveBackup(const std::string& filename);
+
+	// Exports the scene into memory, the format is chosen based on the given filename
+	// Throws an IMapResource::OperationException on failure
+	BackupData serialiseMap(const std::string& filename);
+
+	// Waits for any running background save to complete and processes its result
+	void finishBackgroundSave();
+
+	// Writes the serialised data to disk. Runs on the worker thread.
+	// Returns an empty string on success, the error message otherwise.
+	static std::string writeBackup(const BackupData& data, const std::string& filename, const std::string& infoFileExtension);
+
+	static void collectExistingSnapshots(std::map<int, std::string>& existingSnapshots,
+		const fs::path& snapshotPath, const std::string& mapName, const std::string& mapExtension);
+
+	static std::size_t getSnapshotFolderSize(const std::map<int, std::string>& existingSnapshots);
 
-	void handleSnapshotSizeLimit(const std::map<int, std::string>& existingSnapshots,
-		const fs::path& snapshotPath, const std::string& mapName);
+	// Checks the folder size against the configured limit and keeps track of it in the registry.
+	// Notifies the user when the limit is exceeded for the first time.
+	void handleSnapshotSizeLimit(std::size_t folderSize, const fs::path& snapshotPath, const std::string& mapName);
 };
 
 } // namespace map
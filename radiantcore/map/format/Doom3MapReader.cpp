@@ -5,11 +5,17 @@
 #include "igame.h"
 #include "scene/EntityNode.h"
 #include "string/string.h"
+#include "ibrush.h"
+#include "parser/MapTokeniser.h"
+#include "registry/registry.h"
+#include "util/Parallel.h"
 
 #include "Doom3MapFormat.h"
 
 #include "i18n.h"
 #include <fmt/format.h>
+#include <condition_variable>
+#include <mutex>
 
 #include "primitiveparsers/BrushDef.h"
 #include "primitiveparsers/BrushDef3.h"
@@ -18,6 +24,17 @@
 
 namespace map {
 
+namespace
+{
+	const char* const RKEY_PARALLEL_MAP_LOADING = "user/ui/map/parallelLoading";
+
+	// Small maps are parsed on the calling thread only
+	constexpr std::size_t MIN_PRIMITIVES_PER_THREAD = 512;
+
+	// The number of primitives a thread claims at once
+	constexpr std::size_t PRIMITIVES_PER_CHUNK = 64;
+}
+
 Doom3MapReader::Doom3MapReader(IMapImportFilter& importFilter) :
 	_importFilter(importFilter),
 	_entityCount(0),
@@ -30,11 +47,25 @@ void Doom3MapReader::readFromStream(std::istream& stream)
 	initPrimitiveParsers();
 
 	// The tokeniser used to split the stream into pieces
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+	parser::MapTokeniser tok(stream);
 
 	// Try to parse the map version (throws on failure)
 	parseMapVersion(tok);
 
+	if (registry::getValue<bool>(RKEY_PARALLEL_MAP_LOADING))
+	{
+		parseEntitiesInParallel(tok);
+	}
+	else
+	{
+		parseEntities(tok);
+	}
+
+	// EOF reached, success
+}
+
+void Doom3MapReader::parseEntities(parser::DefTokeniser& tok)
+{
 	// Read each entity in the map, until EOF is reached
 	while (tok.hasMoreTokens())
 	{
@@ -54,8 +85,268 @@ void Doom3MapReader::readFromStream(std::istream& stream)
 
 		_entityCount++;
 	}
+}
 
-	// EOF reached, success
+void Doom3MapReader::parseEntitiesInParallel(parser::MapTokeniser& tok)
+{
+	std::vector<EntityBlock> entities;
+	std::vector<PrimitiveBlock> primitives;
+
+	// Everything from this offset on is left to the regular parser
+	auto sequentialOffset = splitEntityBlocks(tok, entities, primitives);
+	auto contents = tok.getContents();
+
+	auto numThreads = util::getParallelThreadCount(primitives.size(), MIN_PRIMITIVES_PER_THREAD);
+
+	if (numThreads == 1)
+	{
+		// Not worth the effort, parse the whole map on this thread
+		sequentialOffset = entities.empty() ? sequentialOffset : entities.front().offset;
+		entities.clear();
+	}
+
+	auto numChunks = (primitives.size() + PRIMITIVES_PER_CHUNK - 1) / PRIMITIVES_PER_CHUNK;
+
+	std::vector<bool> chunkParsed(numChunks, false);
+	std::mutex chunkMutex;
+	std::condition_variable chunkParsedCondition;
+
+	std::atomic<std::size_t> nextChunk(0);
+	std::atomic<bool> cancelled(false);
+
+	// Claims the next chunk of primitives and parses it, returns false if no chunk is left
+	auto parseNextChunk = [&]()
+	{
+		auto chunk = nextChunk++;
+
+		if (cancelled || chunk >= numChunks) return false;
+
+		auto end = std::min((chunk + 1) * PRIMITIVES_PER_CHUNK, primitives.size());
+
+		for (auto i = chunk * PRIMITIVES_PER_CHUNK; i < end; ++i)
+		{
+			primitives[i].node = parsePrimitiveBlock(primitives[i].text);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(chunkMutex);
+			chunkParsed[chunk] = true;
+		}
+
+		chunkParsedCondition.notify_all();
+		return true;
+	};
+
+	// Blocks until the chunk is done, helping out with the remaining chunks while waiting
+	auto waitForChunk = [&](std::size_t chunk)
+	{
+		std::unique_lock<std::mutex> lock(chunkMutex);
+
+		while (!chunkParsed[chunk])
+		{
+			lock.unlock();
+			bool parsedOther = parseNextChunk();
+			lock.lock();
+
+			if (!parsedOther)
+			{
+				chunkParsedCondition.wait(lock, [&]() { return chunkParsed[chunk]; });
+			}
+		}
+	};
+
+	std::vector<std::future<void>> workers;
+
+	auto stopWorkers = [&]()
+	{
+		cancelled = true;
+
+		for (auto& worker : workers)
+		{
+			worker.wait();
+		}
+	};
+
+	for (std::size_t i = 1; i < numThreads && !entities.empty(); ++i)
+	{
+		workers.emplace_back(std::async(std::launch::async, [&]()
+		{
+			while (parseNextChunk()) {}
+		}));
+	}
+
+	try
+	{
+		// Insert the entities in file order, this keeps the node indices stable
+		for (const auto& entity : entities)
+		{
+			bool complete = true;
+
+			for (auto i = entity.firstPrimitive; i < entity.firstPrimitive + entity.numPrimitives; ++i)
+			{
+				waitForChunk(i / PRIMITIVES_PER_CHUNK);
+
+				if (!primitives[i].node)
+				{
+					complete = false;
+					break;
+				}
+			}
+
+			if (!complete)
+			{
+				// The regular parser takes over from here and produces the proper error message
+				sequentialOffset = entity.offset;
+				break;
+			}
+
+			try
+			{
+				insertEntityBlock(entity, primitives);
+			}
+			catch (FailureException& e)
+			{
+				std::string text = fmt::format(_("Failed parsing entity {0:d}:\n{1}"), _entityCount, e.what());
+
+				// Re-throw with more text
+				throw FailureException(text);
+			}
+
+			_entityCount++;
+		}
+	}
+	catch (...)
+	{
+		stopWorkers();
+		throw;
+	}
+
+	stopWorkers();
+
+	if (sequentialOffset < contents.size())
+	{
+		parser::MapTokeniser remainder(std::string(contents.substr(sequentialOffset)));
+		parseEntities(remainder);
+	}
+}
+
+std::size_t Doom3MapReader::splitEntityBlocks(parser::MapTokeniser& tok,
+	std::vector<EntityBlock>& entities, std::vector<PrimitiveBlock>& primitives) const
+{
+	auto contents = tok.getContents();
+
+	while (tok.hasMoreTokens())
+	{
+		EntityBlock entity;
+		entity.offset = tok.getTokenOffset();
+		entity.firstPrimitive = primitives.size();
+
+		try
+		{
+			if (tok.nextTokenView() != "{")
+			{
+				return entity.offset;
+			}
+
+			while (true)
+			{
+				auto token = tok.nextTokenView();
+
+				if (token == "{") // PRIMITIVE
+				{
+					auto primitiveOffset = tok.getTokenOffset();
+
+					// Skip to the closing brace of the primitive, the parser checks the rest
+					for (std::size_t depth = 1; depth > 0;)
+					{
+						token = tok.nextTokenView();
+
+						if (token == "{") ++depth;
+						else if (token == "}") --depth;
+					}
+
+					primitives.push_back(PrimitiveBlock{
+						contents.substr(primitiveOffset, tok.getTokenOffset() - primitiveOffset), scene::INodePtr()
+					});
+				}
+				else if (token == "}") // END OF ENTITY
+				{
+					break;
+				}
+				else // KEY
+				{
+					std::string key(token);
+					auto value = tok.nextTokenView();
+
+					if (value == "{" || value == "}")
+					{
+						primitives.resize(entity.firstPrimitive);
+						return entity.offset;
+					}
+
+					// The entity is created at its first primitive, later keyvalues are ignored
+					if (primitives.size() == entity.firstPrimitive)
+					{
+						entity.keyValues.insert(EntityKeyValues::value_type(key, value));
+					}
+				}
+			}
+		}
+		catch (parser::ParseException&)
+		{
+			primitives.resize(entity.firstPrimitive);
+			return entity.offset;
+		}
+
+		entity.numPrimitives = primitives.size() - entity.firstPrimitive;
+		entities.emplace_back(std::move(entity));
+	}
+
+	return contents.size();
+}
+
+scene::INodePtr Doom3MapReader::parsePrimitiveBlock(std::string_view text) const
+{
+	try
+	{
+		parser::MapTokeniser tok{ std::string(text) };
+
+		auto p = _primitiveParsers.find(tok.nextToken());
+
+		if (p == _primitiveParsers.end()) return scene::INodePtr();
+
+		auto primitive = p->second->parse(tok);
+
+		// The parser is expected to consume exactly the block found by splitEntityBlocks()
+		if (!primitive || tok.hasMoreTokens()) return scene::INodePtr();
+
+		// Build the brush windings right away, rather than on first access on the main thread
+		IBrush* brush = Node_getIBrush(primitive);
+
+		if (brush != nullptr)
+		{
+			brush->evaluateBRep();
+		}
+
+		return primitive;
+	}
+	catch (std::exception&)
+	{
+		// The main thread will parse this primitive again and report the error
+		return scene::INodePtr();
+	}
+}
+
+void Doom3MapReader::insertEntityBlock(const EntityBlock& entity, const std::vector<PrimitiveBlock>& primitives)
+{
+	auto node = createEntity(entity.keyValues);
+
+	for (_primitiveCount = 0; _primitiveCount < entity.numPrimitives; ++_primitiveCount)
+	{
+		_importFilter.addPrimitiveToEntity(primitives[entity.firstPrimitive + _primitiveCount].node, node);
+	}
+
+	_importFilter.addEntity(node);
 }
 
 void Doom3MapReader::initPrimitiveParsers()
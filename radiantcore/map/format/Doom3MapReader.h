@@ -2,10 +2,14 @@
 #define NODE_IMPORTER_H_
 
 #include <map>
+#include <string_view>
+#include <vector>
 #include "inode.h"
 #include "imapformat.h"
 #include "parser/DefTokeniser.h"
 
+namespace parser { class MapTokeniser; }
+
 namespace map {
 
 class Doom3MapReader :
@@ -43,6 +47,9 @@ protected:
 	// Parse the version tag at the beginning, throws on failure
 	virtual void parseMapVersion(parser::DefTokeniser& tok);
 
+	// Parses all entities until the end of the token stream, throws on failure
+	virtual void parseEntities(parser::DefTokeniser& tok);
+
 	// Parses an entity plus all child primitives, throws on failure
 	virtual void parseEntity(parser::DefTokeniser& tok);
 
@@ -51,6 +58,43 @@ protected:
 
 	// Create an entity with the given properties and layers
 	scene::INodePtr createEntity(const EntityKeyValues& keyValues);
+
+private:
+	// An entity found by splitEntityBlocks(), referring to its primitive blocks
+	struct EntityBlock
+	{
+		// Start of this entity in the map text
+		std::size_t offset;
+
+		// The keyvalues preceding the first primitive (the ones parseEntity() applies)
+		EntityKeyValues keyValues;
+
+		std::size_t firstPrimitive;
+		std::size_t numPrimitives;
+	};
+
+	// The text of a primitive (starting at its keyword) and the node parsed from it
+	struct PrimitiveBlock
+	{
+		std::string_view text;
+		scene::INodePtr node;
+	};
+
+	// Parses the primitives on worker threads while creating the entities and
+	// sending everything to the import filter in file order on this thread
+	void parseEntitiesInParallel(parser::MapTokeniser& tok);
+
+	// Splits the remaining map text into entity and primitive blocks, without creating
+	// any nodes. Stops at anything unexpected and returns the offset of the entity
+	// that has to be left to parseEntities() to get the regular error handling.
+	std::size_t splitEntityBlocks(parser::MapTokeniser& tok, std::vector<EntityBlock>& entities,
+		std::vector<PrimitiveBlock>& primitives) const;
+
+	// Thread-safe primitive parsing, returns an empty node on any failure
+	scene::INodePtr parsePrimitiveBlock(std::string_view text) const;
+
+	// Creates the entity and sends it along with its parsed primitives to the import filter
+	void insertEntityBlock(const EntityBlock& entity, const std::vector<PrimitiveBlock>& primitives);
 };
 
 } // namespace map
@@ -32,7 +32,7 @@ Doom3MapWriter::Doom3MapWriter() :
 void Doom3MapWriter::beginWriteMap(const scene::IMapRootNodePtr& root, std::ostream& stream)
 {
 	// Write the version tag
-	stream << "Version " << MAP_VERSION_D3 << std::endl;
+	stream << "Version " << MAP_VERSION_D3 << '\n';
 }
 
 void Doom3MapWriter::endWriteMap(const scene::IMapRootNodePtr& root, std::ostream& stream)
@@ -43,10 +43,10 @@ void Doom3MapWriter::endWriteMap(const scene::IMapRootNodePtr& root, std::ostrea
 void Doom3MapWriter::beginWriteEntity(const EntityNodePtr& entity, std::ostream& stream)
 {
 	// Write out the entity number comment
-	stream << "// entity " << _entityCount++ << std::endl;
+	stream << "// entity " << _entityCount++ << '\n';
 
 	// Entity opening brace
-	stream << "{" << std::endl;
+	stream << "{\n";
 
 	// Entity key values
 	writeEntityKeyValues(entity, stream);
@@ -57,14 +57,14 @@ void Doom3MapWriter::writeEntityKeyValues(const EntityNodePtr& entity, std::ostr
 	// Export the entity key values
 	entity->getEntity().forEachKeyValue([&](const std::string& key, const std::string& value)
 	{
-		stream << "\"" << escapeEntityKeyValue(key) << "\" \"" << escapeEntityKeyValue(value) << "\"" << std::endl;
+		stream << "\"" << escapeEntityKeyValue(key) << "\" \"" << escapeEntityKeyValue(value) << "\"\n";
 	});
 }
 
 void Doom3MapWriter::endWriteEntity(const EntityNodePtr& entity, std::ostream& stream)
 {
 	// Write the closing brace for the entity
-	stream << "}" << std::endl;
+	stream << "}\n";
 
 	// Reset the primitive count again
 	_primitiveCount = 0;
@@ -73,7 +73,7 @@ void Doom3MapWriter::endWriteEntity(const EntityNodePtr& entity, std::ostream& s
 void Doom3MapWriter::beginWriteBrush(const IBrushNodePtr& brush, std::ostream& stream)
 {
 	// Primitive count comment
-	stream << "// primitive " << _primitiveCount++ << std::endl;
+	stream << "// primitive " << _primitiveCount++ << '\n';
 
 	// Export brushDef3 definition to stream
 	BrushDef3Exporter::exportBrush(stream, brush);
@@ -87,7 +87,7 @@ void Doom3MapWriter::endWriteBrush(const IBrushNodePtr& brush, std::ostream& str
 void Doom3MapWriter::beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream)
 {
 	// Primitive count comment
-	stream << "// primitive " << _primitiveCount++ << std::endl;
+	stream << "// primitive " << _primitiveCount++ << '\n';
 
 	// Export patch here _mapStream
 	PatchDefExporter::exportPatch(stream, patch);
@@ -98,4 +98,22 @@ void Doom3MapWriter::endWritePatch(const IPatchNodePtr& patch, std::ostream& str
 	// nothing
 }
 
+IMapWriterPtr Doom3MapWriter::createConcurrentWriter(std::size_t entityCount, std::size_t primitiveCount)
+{
+	auto writer = createWriter();
+
+	if (writer)
+	{
+		writer->_entityCount = entityCount;
+		writer->_primitiveCount = primitiveCount;
+	}
+
+	return writer;
+}
+
+std::shared_ptr<Doom3MapWriter> Doom3MapWriter::createWriter() const
+{
+	return std::make_shared<Doom3MapWriter>();
+}
+
 } // namespace
@@ -37,8 +37,14 @@ public:
 	virtual void beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 	virtual void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 
+	IMapWriterPtr createConcurrentWriter(std::size_t entityCount, std::size_t primitiveCount) override;
+
 protected:
 	void writeEntityKeyValues(const EntityNodePtr& entity, std::ostream& stream);
+
+	// Creates a new writer of the same type for createConcurrentWriter(),
+	// subclasses which can't be used on worker threads return an empty pointer
+	virtual std::shared_ptr<Doom3MapWriter> createWriter() const;
 };
 
 } // namespace
@@ -0,0 +1,192 @@
+#include "MapTokeniserBenchmark.h"
+
+#include <algorithm>
+#include <fstream>
+#include <fmt/format.h>
+
+#include "imap.h"
+#include "itextstream.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "string/case_conv.h"
+#include "parser/DefTokeniser.h"
+#include "parser/MapTokeniser.h"
+#include "time/StopWatch.h"
+
+namespace map
+{
+
+namespace
+{
+	struct TokeniserResult
+	{
+		std::size_t tokens = 0;
+		std::size_t usecs = 0;
+	};
+
+	std::vector<fs::path> findMapFiles(const fs::path& path)
+	{
+		std::vector<fs::path> files;
+
+		if (fs::is_regular_file(path))
+		{
+			files.push_back(path);
+			return files;
+		}
+
+		if (!fs::is_directory(path)) return files;
+
+		for (const auto& entry : fs::recursive_directory_iterator(path))
+		{
+			if (fs::is_regular_file(entry.path()) &&
+				string::to_lower_copy(entry.path().extension().string()) == ".map")
+			{
+				files.push_back(entry.path());
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+
+		return files;
+	}
+
+	TokeniserResult runDefTokeniser(const fs::path& file)
+	{
+		TokeniserResult result;
+		util::StopWatch timer;
+
+		std::ifstream stream(file.string());
+		parser::BasicDefTokeniser<std::istream> tok(stream);
+
+		while (tok.hasMoreTokens())
+		{
+			tok.nextToken();
+			++result.tokens;
+		}
+
+		result.usecs = timer.getMicroSecondsPassed();
+		return result;
+	}
+
+	TokeniserResult runMapTokeniser(const fs::path& file)
+	{
+		TokeniserResult result;
+		util::StopWatch timer;
+
+		std::ifstream stream(file.string());
+		parser::MapTokeniser tok(stream);
+
+		while (tok.hasMoreTokens())
+		{
+			tok.nextTokenView();
+			++result.tokens;
+		}
+
+		result.usecs = timer.getMicroSecondsPassed();
+		return result;
+	}
+
+	// Returns the index of the first differing token, or -1 if the token sequences are equal
+	long long findFirstMismatch(const fs::path& file)
+	{
+		std::ifstream defStream(file.string());
+		std::ifstream mapStream(file.string());
+
+		parser::BasicDefTokeniser<std::istream> defTok(defStream);
+		parser::MapTokeniser mapTok(mapStream);
+
+		long long index = 0;
+
+		while (defTok.hasMoreTokens() && mapTok.hasMoreTokens())
+		{
+			if (defTok.nextToken() != mapTok.nextTokenView())
+			{
+				return index;
+			}
+
+			++index;
+		}
+
+		return defTok.hasMoreTokens() == mapTok.hasMoreTokens() ? -1 : index;
+	}
+
+	std::string formatThroughput(double megaBytes, std::size_t usecs)
+	{
+		return fmt::format("{0:8.2f} ms ({1:7.1f} MB/s)", usecs / 1000.0,
+			usecs > 0 ? megaBytes * 1000000.0 / usecs : 0.0);
+	}
+}
+
+void benchmarkMapTokeniser(const cmd::ArgumentList& args)
+{
+	fs::path path;
+
+	if (!args.empty())
+	{
+		path = os::standardPath(args[0].getString());
+	}
+	else if (!GlobalMapModule().isUnnamed())
+	{
+		path = GlobalMapModule().getMapName();
+	}
+	else
+	{
+		rWarning() << "Usage: BenchmarkMapTokeniser <path to .map file or folder>" << std::endl;
+		return;
+	}
+
+	std::vector<fs::path> files;
+
+	try
+	{
+		files = findMapFiles(path);
+	}
+	catch (const fs::filesystem_error& ex)
+	{
+		rError() << "Failed to collect map files: " << ex.what() << std::endl;
+		return;
+	}
+
+	if (files.empty())
+	{
+		rWarning() << "No map files found in " << path.string() << std::endl;
+		return;
+	}
+
+	double totalMegaBytes = 0;
+	TokeniserResult defTotal;
+	TokeniserResult mapTotal;
+
+	rMessage() << "Map tokeniser benchmark (" << files.size() << " files)" << std::endl;
+
+	for (const auto& file : files)
+	{
+		double megaBytes = fs::file_size(file) / (1024.0 * 1024.0);
+
+		auto defResult = runDefTokeniser(file);
+		auto mapResult = runMapTokeniser(file);
+
+		rMessage() << "  " << file.filename().string() << fmt::format(" ({0:.1f} MB, {1} tokens)", megaBytes, defResult.tokens) << std::endl
+			<< "    BasicDefTokeniser: " << formatThroughput(megaBytes, defResult.usecs) << std::endl
+			<< "    MapTokeniser:      " << formatThroughput(megaBytes, mapResult.usecs) << std::endl;
+
+		auto mismatch = findFirstMismatch(file);
+
+		if (mismatch != -1)
+		{
+			rError() << "    Token sequences differ at token " << mismatch << std::endl;
+		}
+
+		totalMegaBytes += megaBytes;
+		defTotal.tokens += defResult.tokens;
+		defTotal.usecs += defResult.usecs;
+		mapTotal.tokens += mapResult.tokens;
+		mapTotal.usecs += mapResult.usecs;
+	}
+
+	rMessage() << fmt::format("  Total ({0:.1f} MB, {1} tokens)", totalMegaBytes, defTotal.tokens) << std::endl
+		<< "    BasicDefTokeniser: " << formatThroughput(totalMegaBytes, defTotal.usecs) << std::endl
+		<< "    MapTokeniser:      " << formatThroughput(totalMegaBytes, mapTotal.usecs) << std::endl;
+}
+
+}
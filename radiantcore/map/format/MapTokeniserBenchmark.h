@@ -0,0 +1,18 @@
+#pragma once
+
+#include "icommandsystem.h"
+
+namespace map
+{
+
+/**
+ * Command target comparing the throughput of the stream-based
+ * BasicDefTokeniser with the buffer-based MapTokeniser. Takes the path
+ * to a .map file or a folder which is searched recursively for .map files,
+ * defaulting to the currently loaded map. Both tokenisers are run on each
+ * file, their token sequences are checked for equality.
+ * The results are written to the console.
+ */
+void benchmarkMapTokeniser(const cmd::ArgumentList& args);
+
+}
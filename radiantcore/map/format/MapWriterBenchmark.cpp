@@ -0,0 +1,113 @@
+#include "MapWriterBenchmark.h"
+
+#include <limits>
+#include <sstream>
+#include <fmt/format.h>
+
+#include "imap.h"
+#include "imapformat.h"
+#include "itextstream.h"
+#include "scene/Traverse.h"
+#include "time/StopWatch.h"
+
+#include "../algorithm/MapExporter.h"
+
+namespace map
+{
+
+namespace
+{
+	constexpr std::size_t NUM_RUNS = 3;
+
+	const char* const MAP_FORMATS[] = { "Doom 3", "Quake 4", "Quake 3" };
+
+	struct WriterResult
+	{
+		std::string text;
+		std::size_t usecs = std::numeric_limits<std::size_t>::max();
+	};
+
+	// The export cache is filled by the first run, the other runs measure writing an unchanged map
+	WriterResult runWriter(const MapFormat& format, const scene::IMapRootNodePtr& root, bool concurrent,
+		const MapExportCache::Ptr& exportCache = MapExportCache::Ptr())
+	{
+		WriterResult result;
+
+		for (std::size_t run = 0; run < NUM_RUNS; ++run)
+		{
+			auto writer = format.getMapWriter();
+			std::ostringstream stream;
+
+			// The constructor and destructor are preparing and restoring the scene,
+			// only the writing itself is measured
+			MapExporter exporter(*writer, root, stream);
+			exporter.disableProgressMessages();
+			exporter.setExportCache(exportCache);
+
+			if (concurrent)
+			{
+				exporter.enableConcurrentWriting();
+			}
+			else
+			{
+				exporter.disableConcurrentWriting();
+			}
+
+			util::StopWatch timer;
+			exporter.exportMap(root, scene::traverse);
+			result.usecs = std::min(result.usecs, timer.getMicroSecondsPassed());
+
+			result.text = stream.str();
+		}
+
+		return result;
+	}
+
+	std::string formatThroughput(double megaBytes, std::size_t usecs)
+	{
+		return fmt::format("{0:8.2f} ms ({1:7.1f} MB/s)", usecs / 1000.0,
+			usecs > 0 ? megaBytes * 1000000.0 / usecs : 0.0);
+	}
+}
+
+void benchmarkMapWriters(const cmd::ArgumentList& args)
+{
+	auto root = GlobalMapModule().getRoot();
+
+	if (!root)
+	{
+		rWarning() << "BenchmarkMapWriters: no map loaded" << std::endl;
+		return;
+	}
+
+	rMessage() << "Map writer benchmark (best of " << NUM_RUNS << " runs)" << std::endl;
+
+	for (const auto& formatName : MAP_FORMATS)
+	{
+		auto format = GlobalMapFormatManager().getMapFormatByName(formatName);
+
+		if (!format)
+		{
+			rWarning() << "  Map format " << formatName << " not available" << std::endl;
+			continue;
+		}
+
+		auto sequential = runWriter(*format, root, false);
+		auto concurrent = runWriter(*format, root, true);
+		auto cached = runWriter(*format, root, true, std::make_shared<MapExportCache>());
+
+		double megaBytes = sequential.text.size() / (1024.0 * 1024.0);
+
+		rMessage() << "  " << formatName << fmt::format(" ({0:.1f} MB)", megaBytes) << std::endl
+			<< "    Main thread:    " << formatThroughput(megaBytes, sequential.usecs) << std::endl
+			<< "    Worker threads: " << formatThroughput(megaBytes, concurrent.usecs) << std::endl
+			<< "    Unchanged map:  " << formatThroughput(megaBytes, cached.usecs) << std::endl;
+
+		if (sequential.text != concurrent.text || sequential.text != cached.text)
+		{
+			rError() << "    The outputs differ" << std::endl;
+		}
+	}
+}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "icommandsystem.h"
+
+namespace map
+{
+
+/**
+ * Command target measuring the throughput of the Doom 3, Quake 4 and
+ * Quake 3 map writers. The currently loaded map is exported to memory with
+ * each of them, writing all nodes on the main thread and again using worker
+ * threads. The outputs of both modes are checked for equality, the best
+ * of a few runs is written to the console.
+ */
+void benchmarkMapWriters(const cmd::ArgumentList& args);
+
+}
@@ -5,6 +5,7 @@
 #include "igame.h"
 #include "scene/EntityNode.h"
 #include "string/string.h"
+#include "parser/MapTokeniser.h"
 
 #include "i18n.h"
 #include <fmt/format.h>
@@ -28,7 +29,7 @@ void Quake3MapReader::readFromStream(std::istream& stream)
 	initPrimitiveParsers();
 
 	// The tokeniser used to split the stream into pieces
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+	parser::MapTokeniser tok(stream);
 
 	// Read each entity in the map, until EOF is reached
 	while (tok.hasMoreTokens())
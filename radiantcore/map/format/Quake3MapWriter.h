@@ -19,13 +19,13 @@ public:
 	virtual void beginWriteMap(const scene::IMapRootNodePtr& root, std::ostream& stream) override
 	{
 		// Write an empty line at the beginning of the file
-		stream << std::endl;
+		stream << '\n';
 	}
 
 	virtual void beginWriteBrush(const IBrushNodePtr& brush, std::ostream& stream) override
 	{
 		// Primitive count comment
-		stream << "// brush " << _primitiveCount++ << std::endl;
+		stream << "// brush " << _primitiveCount++ << '\n';
 
 		// Export old brush syntax to stream
 		LegacyBrushDefExporter::exportBrush(stream, brush);
@@ -34,11 +34,19 @@ public:
 	virtual void beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override
 	{
 		// Primitive count comment, not a typo, patches also seem to have "brush" in their comments
-		stream << "// brush " << _primitiveCount++ << std::endl;
+		stream << "// brush " << _primitiveCount++ << '\n';
 
 		// Export patchDef2 to stream (patchDef3 is not supported)
 		PatchDefExporter::exportQ3PatchDef2(stream, patch);
 	}
+
+protected:
+	std::shared_ptr<Doom3MapWriter> createWriter() const override
+	{
+		// The legacy brush syntax needs the editor image sizes, which
+		// can't be loaded from worker threads
+		return std::shared_ptr<Doom3MapWriter>();
+	}
 };
 
 class Quake3AlternateMapWriter :
@@ -49,11 +57,17 @@ public:
 	virtual void beginWriteBrush(const IBrushNodePtr& brush, std::ostream& stream) override
 	{
 		// Primitive count comment
-		stream << "// brush " << _primitiveCount++ << std::endl;
+		stream << "// brush " << _primitiveCount++ << '\n';
 
 		// Export brushDef definition to stream
 		BrushDefExporter::exportBrush(stream, brush);
 	}
+
+protected:
+	std::shared_ptr<Doom3MapWriter> createWriter() const override
+	{
+		return std::make_shared<Quake3AlternateMapWriter>();
+	}
 };
 
 } // namespace
@@ -1,6 +1,3 @@
-// greebo: Specialise the float casting function
-#define SPECIALISE_STR_TO_FLOAT
-
 #include "BrushDef.h"
 
 #include "../Quake3Utils.h"
@@ -66,25 +63,25 @@ scene::INodePtr BrushDefParser::parse(parser::DefTokeniser& tok) const
 		else if (token == "(") // FACE
 		{
 			// Parse three 3D points to construct a plane
-			double x = string::to_float(tok.nextToken());
-			double y = string::to_float(tok.nextToken());
-			double z = string::to_float(tok.nextToken());
+			double x = tok.nextDouble();
+			double y = tok.nextDouble();
+			double z = tok.nextDouble();
 			Vector3 p1(x, y, z);
 
 			tok.assertNextToken(")");
 			tok.assertNextToken("(");
 
-			x = string::to_float(tok.nextToken());
-			y = string::to_float(tok.nextToken());
-			z = string::to_float(tok.nextToken());
+			x = tok.nextDouble();
+			y = tok.nextDouble();
+			z = tok.nextDouble();
 			Vector3 p2(x, y, z);
 
 			tok.assertNextToken(")");
 			tok.assertNextToken("(");
 
-			x = string::to_float(tok.nextToken());
-			y = string::to_float(tok.nextToken());
-			z = string::to_float(tok.nextToken());
+			x = tok.nextDouble();
+			y = tok.nextDouble();
+			z = tok.nextDouble();
 			Vector3 p3(x, y, z);
 
 			tok.assertNextToken(")");
@@ -97,15 +94,15 @@ scene::INodePtr BrushDefParser::parse(parser::DefTokeniser& tok) const
 			tok.assertNextToken("(");
 
 			tok.assertNextToken("(");
-			texdef.xx() = string::to_float(tok.nextToken());
-			texdef.yx() = string::to_float(tok.nextToken());
-			texdef.zx() = string::to_float(tok.nextToken());
+			texdef.xx() = tok.nextDouble();
+			texdef.yx() = tok.nextDouble();
+			texdef.zx() = tok.nextDouble();
 			tok.assertNextToken(")");
 
 			tok.assertNextToken("(");
-			texdef.xy() = string::to_float(tok.nextToken());
-			texdef.yy() = string::to_float(tok.nextToken());
-			texdef.zy() = string::to_float(tok.nextToken());
+			texdef.xy() = tok.nextDouble();
+			texdef.yy() = tok.nextDouble();
+			texdef.zy() = tok.nextDouble();
 			tok.assertNextToken(")");
 
 			tok.assertNextToken(")");
@@ -185,25 +182,25 @@ scene::INodePtr LegacyBrushDefParser::parse(parser::DefTokeniser& tok) const
 		else if (token == "(") // FACE
 		{
 			// Parse three 3D points to construct a plane
-			double x = string::to_float(tok.nextToken());
-			double y = string::to_float(tok.nextToken());
-			double z = string::to_float(tok.nextToken());
+			double x = tok.nextDouble();
+			double y = tok.nextDouble();
+			double z = tok.nextDouble();
 			Vector3 p1(x, y, z);
 
 			tok.assertNextToken(")");
 			tok.assertNextToken("(");
 
-			x = string::to_float(tok.nextToken());
-			y = string::to_float(tok.nextToken());
-			z = string::to_float(tok.nextToken());
+			x = tok.nextDouble();
+			y = tok.nextDouble();
+			z = tok.nextDouble();
 			Vector3 p2(x, y, z);
 
 			tok.assertNextToken(")");
 			tok.assertNextToken("(");
 
-			x = string::to_float(tok.nextToken());
-			y = string::to_float(tok.nextToken());
-			z = string::to_float(tok.nextToken());
+			x = tok.nextDouble();
+			y = tok.nextDouble();
+			z = tok.nextDouble();
 			Vector3 p3(x, y, z);
 
 			tok.assertNextToken(")");
@@ -217,13 +214,13 @@ scene::INodePtr LegacyBrushDefParser::parse(parser::DefTokeniser& tok) const
 			// Parse texdef (shift rotation scale)
 			ShiftScaleRotation ssr;
 
-			ssr.shift[0] = string::to_float(tok.nextToken());
-			ssr.shift[1] = string::to_float(tok.nextToken());
+			ssr.shift[0] = tok.nextDouble();
+			ssr.shift[1] = tok.nextDouble();
 
-			ssr.rotate = string::to_float(tok.nextToken());
+			ssr.rotate = tok.nextDouble();
 
-			ssr.scale[0] = string::to_float(tok.nextToken());
-			ssr.scale[1] = string::to_float(tok.nextToken());
+			ssr.scale[0] = tok.nextDouble();
+			ssr.scale[1] = tok.nextDouble();
 
 			if (ssr.scale[0] == 0)
 			{
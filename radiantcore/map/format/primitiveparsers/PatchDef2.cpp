@@ -1,6 +1,3 @@
-// greebo: Specialise the float casting function
-#define SPECIALISE_STR_TO_FLOAT
-
 #include "PatchDef2.h"
 
 #include "imap.h"
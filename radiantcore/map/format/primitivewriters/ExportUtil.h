@@ -1,11 +1,31 @@
 #pragma once
 
 #include <ostream>
+#include <charconv>
 #include "math/FloatTools.h"
 
 namespace map
 {
 
+// Writes a double to the stream, using the stream's precision like operator<< does.
+// std::to_chars() doesn't go through the stream's locale and sentry machinery,
+// which makes up most of the time spent in writing the map primitives.
+inline void writeDouble(const double d, std::ostream& os)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	char buffer[32];
+	auto result = std::to_chars(buffer, buffer + sizeof(buffer), d,
+		std::chars_format::general, static_cast<int>(os.precision()));
+
+	if (result.ec == std::errc())
+	{
+		os.write(buffer, result.ptr - buffer);
+		return;
+	}
+#endif
+	os << d;
+}
+
 // Writes a double to the given stream and checks for NaN and infinity
 inline void writeDoubleSafe(const double d, std::ostream& os)
 {
@@ -13,17 +33,17 @@ inline void writeDoubleSafe(const double d, std::ostream& os)
 	{
 		if (d == -0.0)
 		{
-			os << 0; // convert -0 to 0
+			os << '0'; // convert -0 to 0
 		}
 		else
 		{
-			os << d;
+			writeDouble(d, os);
 		}
 	}
 	else
 	{
 		// Is infinity or NaN, write 0
-		os << "0";
+		os << '0';
 	}
 }
 
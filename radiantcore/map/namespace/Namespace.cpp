@@ -3,6 +3,7 @@
 #include "inameobserver.h"
 #include "itextstream.h"
 #include "module/StaticModule.h"
+#include "UniqueNameSetOverlay.h"
 
 #include <list>
 
@@ -280,11 +281,10 @@ void Namespace::ensureNoConflicts(const scene::INodePtr& foreignRoot, const std:
     rDebug() << "Namespace::ensureNoConflicts(): importing set of "
         << foreignNodes.size() << " namespaced nodes" << std::endl;
 
-    // Build a union set containing all imported names and all existing names.
+    // Layer the imported names over all existing names without copying them.
     // We need to know all existing names to ensure that newly created names are
     // unique in *both* namespaces
-    UniqueNameSet allNames = _uniqueNames;
-    allNames.merge(foreignNamespace._uniqueNames);
+    UniqueNameSetOverlay allNames(_uniqueNames, foreignNamespace._uniqueNames);
 
     // Process each object in the to-be-imported tree of nodes, ensuring that it
     // has a unique name
@@ -292,6 +292,7 @@ void Namespace::ensureNoConflicts(const scene::INodePtr& foreignRoot, const std:
     {
         // If the imported node conflicts with a name in THIS namespace, then it
         // needs to be given a new name which is unique in BOTH namespaces.
+        // Names not conflicting are already part of the imported layer.
         if (_uniqueNames.nameExists(foreignNode->getName()))
         {
             // Name exists in the target namespace, get a new name
@@ -305,13 +306,6 @@ void Namespace::ensureNoConflicts(const scene::INodePtr& foreignRoot, const std:
             // observers in the foreign namespace
             foreignNode->changeName(uniqueName);
         }
-        else
-        {
-            // Name does not exist yet, insert it into the local combined
-            // namespace (but not our destination namespace, this will be
-            // populated in the subsequent call to connect()).
-            allNames.insert(foreignNode->getName());
-        }
     }
 
     // at this point, all names in the foreign namespace have been converted to
@@ -162,6 +162,17 @@ public:
 		return false;
 	}
 
+	/**
+	 * Returns the postfixes used with the given name prefix,
+	 * or nullptr if the prefix is not known to this set.
+	 */
+	const PostfixSet* getPostfixes(const std::string& prefix) const
+	{
+		Names::const_iterator found = _names.find(prefix);
+
+		return found != _names.end() ? &found->second : nullptr;
+	}
+
 	/**
 	 * Copies all names from the <other> UniqueNameSet into this one.
 	 * This class will contain the union of both sets afterwards.
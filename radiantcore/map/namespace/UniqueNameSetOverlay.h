@@ -0,0 +1,92 @@
+#pragma once
+
+#include <map>
+
+#include "string/convert.h"
+#include "UniqueNameSet.h"
+
+/**
+ * \brief
+ * Layers the names added during an import over the names of the target
+ * namespace and the imported nodes, without copying any of these sets.
+ * A name is considered used if it is present in any of the layers.
+ *
+ * Names are never removed from the union of the layers while the overlay
+ * is in use, so the overlay can remember the lowest postfix number which
+ * might still be free for each prefix. Renaming many imported nodes with
+ * the same prefix continues where the previous rename stopped, instead of
+ * probing all numbers from 1 again.
+ */
+class UniqueNameSetOverlay
+{
+	const UniqueNameSet& _targetNames;
+	const UniqueNameSet& _importedNames;
+
+	// The names allocated through this overlay
+	UniqueNameSet _addedNames;
+
+	// Maps name prefixes to the next postfix number to try,
+	// all numbers below it are used in one of the layers
+	std::map<std::string, int> _nextPostfix;
+
+public:
+	UniqueNameSetOverlay(const UniqueNameSet& targetNames, const UniqueNameSet& importedNames) :
+		_targetNames(targetNames),
+		_importedNames(importedNames)
+	{}
+
+	/**
+	 * \brief
+	 * Adds the given name to the overlay, changing its postfix if necessary
+	 * to make it unique in all layers.
+	 *
+	 * \return
+	 * The actual unique name that was used.
+	 */
+	std::string insertUnique(const ComplexName& name)
+	{
+		const auto& prefix = name.getNameWithoutPostfix();
+
+		const PostfixSet* layers[] =
+		{
+			_targetNames.getPostfixes(prefix),
+			_importedNames.getPostfixes(prefix),
+			_addedNames.getPostfixes(prefix),
+		};
+
+		auto isUsed = [&](const std::string& postfix)
+		{
+			for (auto postfixes : layers)
+			{
+				if (postfixes && postfixes->find(postfix) != postfixes->end())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		if (!isUsed(name.getPostfix()))
+		{
+			_addedNames.insert(name);
+			return name.getFullname();
+		}
+
+		auto& nextPostfix = _nextPostfix.emplace(prefix, 1).first->second;
+
+		std::string postfix = string::to_string(nextPostfix);
+
+		while (isUsed(postfix))
+		{
+			postfix = string::to_string(++nextPostfix);
+		}
+
+		++nextPostfix;
+
+		ComplexName uniqueName(prefix + postfix);
+		_addedNames.insert(uniqueName);
+
+		return uniqueName.getFullname();
+	}
+};
@@ -3,6 +3,8 @@
 #include "imodel.h"
 #include "iparticlenode.h"
 #include "iparticles.h"
+#include "iscenegraph.h"
+#include "itextstream.h"
 
 #include "os/path.h"
 #include "os/file.h"
@@ -16,7 +18,8 @@ namespace model
 {
 
 ModelCache::ModelCache() :
-	_enabled(true)
+	_enabled(true),
+	_shutdown(false)
 {}
 
 scene::INodePtr ModelCache::getModelNode(const std::string& modelPath)
@@ -40,6 +43,185 @@ scene::INodePtr ModelCache::getModelNode(const std::string& modelPath)
 	return node ? node : loadNullModel(modelPath);
 }
 
+scene::INodePtr ModelCache::getModelNodeAsync(const std::string& modelPath, const ModelNodeCallback& callback)
+{
+	if (_shutdown || !isCacheable(modelPath))
+	{
+		return getModelNode(modelPath);
+	}
+
+	if (_modelMap.count(modelPath) > 0)
+	{
+		return getModelNode(modelPath);
+	}
+
+	requestModelNode(modelPath, callback);
+
+	return loadNullModel(modelPath);
+}
+
+void ModelCache::requestModelNode(const std::string& modelPath, const ModelNodeCallback& callback)
+{
+	if (_shutdown) return;
+
+	auto pending = _pendingModels.find(modelPath);
+
+	if (pending == _pendingModels.end())
+	{
+		// First request for this model, queue it
+		pending = _pendingModels.emplace(modelPath, std::vector<ModelNodeCallback>()).first;
+
+		IModelPtr cachedModel;
+
+		if (auto found = _modelMap.find(modelPath); found != _modelMap.end() && isCacheable(modelPath))
+		{
+			cachedModel = found->second;
+		}
+
+		if (cachedModel || !isCacheable(modelPath))
+		{
+			// Nothing to parse, hand it out on the next call to processLoadedModels()
+			std::lock_guard<std::mutex> lock(_loadQueueLock);
+			_loadedModels.emplace_back(modelPath, cachedModel);
+		}
+		else
+		{
+			startLoaderThreads();
+
+			{
+				std::lock_guard<std::mutex> lock(_loadQueueLock);
+				_loadQueue.push_back(modelPath);
+			}
+
+			_loadQueueSignal.notify_one();
+		}
+	}
+
+	pending->second.push_back(callback);
+}
+
+bool ModelCache::isModelPending(const std::string& modelPath) const
+{
+	return _pendingModels.count(modelPath) > 0;
+}
+
+bool ModelCache::isCacheable(const std::string& modelPath) const
+{
+	return os::getExtension(modelPath) != "prt" && !path_is_absolute(modelPath.c_str());
+}
+
+bool ModelCache::processLoadedModels()
+{
+	std::vector<std::pair<std::string, IModelPtr>> loadedModels;
+
+	{
+		std::lock_guard<std::mutex> lock(_loadQueueLock);
+		loadedModels.swap(_loadedModels);
+	}
+
+	if (loadedModels.empty()) return false;
+
+	for (const auto& [modelPath, model] : loadedModels)
+	{
+		if (model && isCacheable(modelPath) && _modelMap.count(modelPath) == 0)
+		{
+			insertParsedModel(modelPath, model);
+		}
+
+		auto pending = _pendingModels.find(modelPath);
+
+		if (pending == _pendingModels.end()) continue;
+
+		auto callbacks = std::move(pending->second);
+		_pendingModels.erase(pending);
+
+		for (auto& callback : callbacks)
+		{
+			// Requesters might have been destroyed in the meantime
+			if (callback.empty()) continue;
+
+			// Every requester gets its own node, constructed from the cached model
+			callback(model || !isCacheable(modelPath) ? getModelNode(modelPath) : loadNullModel(modelPath));
+		}
+	}
+
+	SceneChangeNotify();
+
+	return true;
+}
+
+std::size_t ModelCache::getNumPendingModels() const
+{
+	return _pendingModels.size();
+}
+
+void ModelCache::startLoaderThreads()
+{
+	if (!_loaderThreads.empty()) return;
+
+	auto numThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	for (unsigned int i = 0; i < numThreads; ++i)
+	{
+		_loaderThreads.emplace_back(&ModelCache::processLoadQueue, this);
+	}
+}
+
+void ModelCache::stopLoaderThreads()
+{
+	{
+		std::lock_guard<std::mutex> lock(_loadQueueLock);
+		_shutdown = true;
+		_loadQueue.clear();
+	}
+
+	_loadQueueSignal.notify_all();
+
+	for (auto& thread : _loaderThreads)
+	{
+		thread.join();
+	}
+
+	_loaderThreads.clear();
+	_loadedModels.clear();
+	_pendingModels.clear();
+}
+
+void ModelCache::processLoadQueue()
+{
+	while (true)
+	{
+		std::string modelPath;
+
+		{
+			std::unique_lock<std::mutex> lock(_loadQueueLock);
+
+			_loadQueueSignal.wait(lock, [this]() { return _shutdown || !_loadQueue.empty(); });
+
+			if (_shutdown) return;
+
+			modelPath = _loadQueue.front();
+			_loadQueue.pop_front();
+		}
+
+		// Parse the file, the model is completed and put into the
+		// cache on the main thread which constructs the nodes
+		IModelPtr model;
+
+		try
+		{
+			model = GlobalModelFormatManager().getImporter(os::getExtension(modelPath))->parseModelFromPath(modelPath);
+		}
+		catch (const std::exception& ex)
+		{
+			rError() << "Failed to load model " << modelPath << ": " << ex.what() << std::endl;
+		}
+
+		std::lock_guard<std::mutex> lock(_loadQueueLock);
+		_loadedModels.emplace_back(modelPath, model);
+	}
+}
+
 IModelPtr ModelCache::getModel(const std::string& modelPath)
 {
 	// Try to lookup the existing model
@@ -69,6 +251,13 @@ IModelPtr ModelCache::getModel(const std::string& modelPath)
 	return model;
 }
 
+void ModelCache::insertParsedModel(const std::string& modelPath, const IModelPtr& model)
+{
+	GlobalModelFormatManager().getImporter(os::getExtension(modelPath))->finishModelLoad(model);
+
+	_modelMap.emplace(modelPath, model);
+}
+
 scene::INodePtr ModelCache::getModelNodeForStaticResource(const std::string& resourcePath)
 {
 	// Get the extension of this model
@@ -156,6 +345,7 @@ void ModelCache::initialiseModule(const IApplicationContext& ctx)
 
 void ModelCache::shutdownModule()
 {
+	stopLoaderThreads();
 	clear();
 }
 
@@ -1,7 +1,12 @@
 #pragma once
 
 #include <map>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+#include <condition_variable>
 #include "imodelcache.h"
 #include "icommandsystem.h"
 
@@ -12,13 +17,28 @@ class ModelCache :
 	public IModelCache
 {
 private:
-	// The container maps model names to instances
+	// The container maps model names to instances, only accessed by the main
+	// thread. The loader threads hand their models to processLoadedModels().
 	typedef std::map<std::string, IModelPtr> ModelMap;
 	ModelMap _modelMap;
 
 	// Flag to disable the cache on demand (used during clear())
 	bool _enabled;
 
+	// The requesters waiting for a model loaded in the background, by model path
+	std::map<std::string, std::vector<ModelNodeCallback>> _pendingModels;
+
+	// The paths waiting for a loader thread and the finished models,
+	// both guarded by the mutex
+	std::deque<std::string> _loadQueue;
+	std::vector<std::pair<std::string, IModelPtr>> _loadedModels;
+	std::mutex _loadQueueLock;
+	std::condition_variable _loadQueueSignal;
+
+	// Started on first use
+	std::vector<std::thread> _loaderThreads;
+	bool _shutdown;
+
 	sigc::signal<void> _sigModelsReloaded;
 
 public:
@@ -27,6 +47,12 @@ public:
 	// greebo: For documentation, see the abstract base class.
 	scene::INodePtr getModelNode(const std::string& modelPath) override;
 
+	scene::INodePtr getModelNodeAsync(const std::string& modelPath, const ModelNodeCallback& callback) override;
+	void requestModelNode(const std::string& modelPath, const ModelNodeCallback& callback) override;
+	bool isModelPending(const std::string& modelPath) const override;
+	bool processLoadedModels() override;
+	std::size_t getNumPendingModels() const override;
+
 	// greebo: For documentation, see the abstract base class.
 	IModelPtr getModel(const std::string& modelPath) override;
 
@@ -51,6 +77,16 @@ public:
 private:
 	scene::INodePtr loadNullModel(const std::string& modelPath);
 
+	// Particles and absolute paths are not going through the cache
+	bool isCacheable(const std::string& modelPath) const;
+
+	// Completes a model parsed by a loader thread and puts it into the cache
+	void insertParsedModel(const std::string& modelPath, const IModelPtr& model);
+
+	void startLoaderThreads();
+	void stopLoaderThreads();
+	void processLoadQueue();
+
 	// Command targets
 	void refreshModelsCmd(const cmd::ArgumentList& args);
 	void refreshSelectedModelsCmd(const cmd::ArgumentList& args);
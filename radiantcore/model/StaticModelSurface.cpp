@@ -30,7 +30,8 @@ StaticModelSurface::StaticModelSurface(const StaticModelSurface& other) :
 	_defaultMaterial(other._defaultMaterial),
 	_vertices(other._vertices),
 	_indices(other._indices),
-	_localAABB(other._localAABB)
+	_localAABB(other._localAABB),
+	_bvh(other._bvh)
 {}
 
 void StaticModelSurface::calculateTangents()
@@ -67,12 +68,8 @@ void StaticModelSurface::testSelect(Selector& selector, SelectionTest& test,
 		test.BeginMesh(localToWorld, twoSided);
 		SelectionIntersection result;
 
-		test.TestTriangles(
-			VertexPointer(&_vertices[0].vertex, sizeof(MeshVertex)),
-			IndexPointer(&_indices[0],
-						 IndexPointer::index_type(_indices.size())),
-			result
-		);
+		// Only the triangles near the selection volume are tested
+		getBVH().testSelect(_vertices, test, localToWorld, result);
 
 		// Add the intersection to the selector if it is valid
 		if(result.isValid()) {
@@ -134,6 +131,16 @@ void StaticModelSurface::setDefaultMaterial(const std::string& defaultMaterial)
 	_defaultMaterial = defaultMaterial;
 }
 
+const std::string& StaticModelSurface::getFallbackMaterial() const
+{
+	return _fallbackMaterial;
+}
+
+void StaticModelSurface::setFallbackMaterial(const std::string& fallbackMaterial)
+{
+	_fallbackMaterial = fallbackMaterial;
+}
+
 const std::string& StaticModelSurface::getActiveMaterial() const
 {
 	return !_activeMaterial.empty() ? _activeMaterial : _defaultMaterial;
@@ -151,43 +158,17 @@ const AABB& StaticModelSurface::getSurfaceBounds() const
 
 bool StaticModelSurface::getIntersection(const Ray& ray, Vector3& intersection, const Matrix4& localToWorld)
 {
-	Vector3 bestIntersection = ray.origin;
-	Vector3 triIntersection;
+	return getBVH().getIntersection(_vertices, ray, localToWorld, intersection);
+}
 
-	for (Indices::const_iterator i = _indices.begin();
-		 i != _indices.end();
-		 i += 3)
+const TriangleBVH& StaticModelSurface::getBVH() const
+{
+	if (_bvh.empty())
 	{
-		// Get the vertices for this triangle
-		const MeshVertex& p1 = _vertices[*(i)];
-		const MeshVertex& p2 = _vertices[*(i+1)];
-		const MeshVertex& p3 = _vertices[*(i+2)];
-
-		if (ray.intersectTriangle(localToWorld.transformPoint(p1.vertex), 
-			localToWorld.transformPoint(p2.vertex), localToWorld.transformPoint(p3.vertex), triIntersection))
-		{
-			intersection = triIntersection;
-			
-			// Test if this surface intersection is better than what we currently have
-			auto oldDistSquared = (bestIntersection - ray.origin).getLengthSquared();
-			auto newDistSquared = (triIntersection - ray.origin).getLengthSquared();
-
-			if ((oldDistSquared == 0 && newDistSquared > 0) || newDistSquared < oldDistSquared)
-			{
-				bestIntersection = triIntersection;
-			}
-		}
+		_bvh.build(_vertices, _indices);
 	}
 
-	if ((bestIntersection - ray.origin).getLengthSquared() > 0)
-	{
-		intersection = bestIntersection;
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	return _bvh;
 }
 
 void StaticModelSurface::applyScale(const Vector3& scale, const StaticModelSurface& originalSurface)
@@ -215,6 +196,9 @@ void StaticModelSurface::applyScale(const Vector3& scale, const StaticModelSurfa
 	}
 
 	calculateTangents();
+
+	// The triangles moved, rebuild the hierarchy on next use
+	_bvh.clear();
 }
 
 } // namespace model
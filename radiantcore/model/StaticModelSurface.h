@@ -4,6 +4,7 @@
 #include "ishaders.h"
 
 #include "math/AABB.h"
+#include "TriangleBVH.h"
 
 /* FORWARD DECLS */
 class ModelSkin;
@@ -34,6 +35,9 @@ private:
 	// Name of the material with skin remaps applied
 	std::string _activeMaterial;
 
+	// Material to use instead of the default one if that doesn't exist (ASE material name)
+	std::string _fallbackMaterial;
+
 	// Vector of MeshVertex structures, containing the coordinates,
 	// normals, tangents and texture coordinates of the component vertices
 	typedef std::vector<MeshVertex> VertexVector;
@@ -47,10 +51,15 @@ private:
 	// The AABB containing this surface, in local object space.
 	AABB _localAABB;
 
+	// Triangle hierarchy for selection and ray tests, built on first use
+	mutable TriangleBVH _bvh;
+
 private:
 	// Calculate tangent and bitangent vectors for all vertices.
 	void calculateTangents();
 
+	const TriangleBVH& getBVH() const;
+
 public:
 	// Move-construct this static model surface from the given vertex- and index array
 	StaticModelSurface(std::vector<MeshVertex>&& vertices, std::vector<unsigned int>&& indices);
@@ -83,6 +92,9 @@ public:
 	const std::string& getDefaultMaterial() const override;
 	void setDefaultMaterial(const std::string& defaultMaterial);
 
+	const std::string& getFallbackMaterial() const;
+	void setFallbackMaterial(const std::string& fallbackMaterial);
+
 	const std::string& getActiveMaterial() const override;
 	void setActiveMaterial(const std::string& activeMaterial);
 
@@ -0,0 +1,209 @@
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include "iselectiontest.h"
+#include "ivolumetest.h"
+#include "math/Ray.h"
+
+namespace model
+{
+
+namespace
+{
+    // Nodes with up to this many triangles are not split any further
+    constexpr std::size_t MAX_TRIANGLES_PER_LEAF = 8;
+
+    // The tree is balanced, its depth is logarithmic in the number of triangles
+    constexpr std::size_t MAX_STACK_SIZE = 64;
+
+    // Node bounds are padded a bit, such that rays hitting triangles
+    // on the faces of the box are not lost to rounding errors
+    constexpr double BOUNDS_PADDING = 0.01;
+}
+
+void TriangleBVH::build(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    clear();
+
+    auto numTriangles = indices.size() / 3;
+
+    if (numTriangles == 0) return;
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(numTriangles);
+
+    for (std::size_t i = 0; i < numTriangles; ++i)
+    {
+        AABB bounds;
+        bounds.includePoint(vertices[indices[i * 3]].vertex);
+        bounds.includePoint(vertices[indices[i * 3 + 1]].vertex);
+        bounds.includePoint(vertices[indices[i * 3 + 2]].vertex);
+
+        triangles.emplace_back(Triangle{ bounds, i });
+    }
+
+    _nodes.reserve(2 * numTriangles / MAX_TRIANGLES_PER_LEAF + 1);
+
+    buildNode(triangles, 0, numTriangles);
+
+    // Store the indices in the order of the partitioned triangles
+    _indices.reserve(indices.size());
+
+    for (const auto& triangle : triangles)
+    {
+        _indices.push_back(indices[triangle.index * 3]);
+        _indices.push_back(indices[triangle.index * 3 + 1]);
+        _indices.push_back(indices[triangle.index * 3 + 2]);
+    }
+}
+
+void TriangleBVH::clear()
+{
+    _nodes.clear();
+    _indices.clear();
+}
+
+void TriangleBVH::testSelect(const std::vector<MeshVertex>& vertices, SelectionTest& test,
+    const Matrix4& localToWorld, SelectionIntersection& best) const
+{
+    if (_nodes.empty()) return;
+
+    const auto& volume = test.getVolume();
+    VertexPointer vertexPointer(&vertices[0].vertex, sizeof(MeshVertex));
+
+    std::size_t stack[MAX_STACK_SIZE];
+    std::size_t stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        auto nodeIndex = stack[--stackSize];
+        const auto& node = _nodes[nodeIndex];
+
+        if (volume.TestAABB(node.bounds, localToWorld) == VOLUME_OUTSIDE) continue;
+
+        if (node.numTriangles > 0)
+        {
+            test.TestTriangles(vertexPointer,
+                IndexPointer(&_indices[node.firstTriangle * 3], IndexPointer::index_type(node.numTriangles * 3)),
+                best);
+            continue;
+        }
+
+        stack[stackSize++] = node.secondChild;
+        stack[stackSize++] = nodeIndex + 1;
+    }
+}
+
+bool TriangleBVH::getIntersection(const std::vector<MeshVertex>& vertices, const Ray& ray,
+    const Matrix4& localToWorld, Vector3& intersection) const
+{
+    if (_nodes.empty()) return false;
+
+    // Transform the ray into model space instead of every vertex to world space
+    auto worldToLocal = localToWorld.getFullInverse();
+    Ray localRay(worldToLocal.transformPoint(ray.origin), worldToLocal.transformDirection(ray.direction));
+
+    Vector3 bestIntersection = ray.origin;
+    Vector3 triIntersection;
+    Vector3 boxIntersection;
+
+    std::size_t stack[MAX_STACK_SIZE];
+    std::size_t stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        auto nodeIndex = stack[--stackSize];
+        const auto& node = _nodes[nodeIndex];
+
+        if (!localRay.intersectAABB(node.bounds, boxIntersection)) continue;
+
+        if (node.numTriangles == 0)
+        {
+            stack[stackSize++] = node.secondChild;
+            stack[stackSize++] = nodeIndex + 1;
+            continue;
+        }
+
+        for (auto i = node.firstTriangle * 3; i < (node.firstTriangle + node.numTriangles) * 3; i += 3)
+        {
+            if (localRay.intersectTriangle(vertices[_indices[i]].vertex, vertices[_indices[i + 1]].vertex,
+                vertices[_indices[i + 2]].vertex, triIntersection) != Ray::POINT)
+            {
+                continue;
+            }
+
+            auto worldIntersection = localToWorld.transformPoint(triIntersection);
+
+            // Test if this surface intersection is better than what we currently have
+            auto oldDistSquared = (bestIntersection - ray.origin).getLengthSquared();
+            auto newDistSquared = (worldIntersection - ray.origin).getLengthSquared();
+
+            if ((oldDistSquared == 0 && newDistSquared > 0) || newDistSquared < oldDistSquared)
+            {
+                bestIntersection = worldIntersection;
+            }
+        }
+    }
+
+    if ((bestIntersection - ray.origin).getLengthSquared() > 0)
+    {
+        intersection = bestIntersection;
+        return true;
+    }
+
+    return false;
+}
+
+std::size_t TriangleBVH::buildNode(std::vector<Triangle>& triangles, std::size_t firstTriangle, std::size_t numTriangles)
+{
+    auto nodeIndex = _nodes.size();
+    _nodes.emplace_back(Node{ AABB(), firstTriangle, numTriangles, 0 });
+
+    auto begin = triangles.begin() + firstTriangle;
+    auto end = begin + numTriangles;
+
+    AABB bounds;
+    AABB centres;
+
+    for (auto i = begin; i != end; ++i)
+    {
+        bounds.includeAABB(i->bounds);
+        centres.includePoint(i->bounds.getOrigin());
+    }
+
+    bounds.extents += Vector3(BOUNDS_PADDING, BOUNDS_PADDING, BOUNDS_PADDING);
+    _nodes[nodeIndex].bounds = bounds;
+
+    if (numTriangles <= MAX_TRIANGLES_PER_LEAF) return nodeIndex;
+
+    // Split the triangles at the median along the axis their centres are spread the most
+    const auto& extents = centres.getExtents();
+    auto axis = extents.x() >= extents.y() ?
+        (extents.x() >= extents.z() ? 0 : 2) :
+        (extents.y() >= extents.z() ? 1 : 2);
+
+    // No point in splitting triangles sharing the same centre
+    if (extents[axis] <= 0) return nodeIndex;
+
+    auto half = numTriangles / 2;
+
+    std::nth_element(begin, begin + half, end, [&](const Triangle& a, const Triangle& b)
+    {
+        return a.bounds.getOrigin()[axis] < b.bounds.getOrigin()[axis];
+    });
+
+    _nodes[nodeIndex].numTriangles = 0;
+
+    buildNode(triangles, firstTriangle, half);
+    auto secondChild = buildNode(triangles, firstTriangle + half, numTriangles - half);
+
+    _nodes[nodeIndex].secondChild = secondChild;
+
+    return nodeIndex;
+}
+
+}
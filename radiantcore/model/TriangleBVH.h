@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include "render/MeshVertex.h"
+#include "math/AABB.h"
+#include "math/Matrix4.h"
+
+class Ray;
+class SelectionTest;
+class SelectionIntersection;
+
+namespace model
+{
+
+/**
+ * Bounding volume hierarchy of the triangles of a model surface, in model space.
+ *
+ * Selection tests and ray queries only need to look at the triangles in the
+ * leaves touching the selection volume or the ray, instead of going through
+ * the whole index buffer. The hierarchy refers to the vertex array of the
+ * surface by index, it needs to be rebuilt when the vertices are moved.
+ */
+class TriangleBVH
+{
+private:
+    struct Node
+    {
+        // Bounds of all triangles below this node
+        AABB bounds;
+
+        // Leaf nodes refer to a range of triangles, inner nodes have a triangle
+        // count of 0. The first child of an inner node is stored right after it.
+        std::size_t firstTriangle;
+        std::size_t numTriangles;
+        std::size_t secondChild;
+    };
+
+    struct Triangle
+    {
+        AABB bounds;
+        std::size_t index;
+    };
+
+    std::vector<Node> _nodes;
+
+    // The vertex indices of the surface, reordered such that the
+    // triangles of each leaf node are stored contiguously
+    std::vector<unsigned int> _indices;
+
+public:
+    bool empty() const
+    {
+        return _nodes.empty();
+    }
+
+    // (Re-)builds the hierarchy from the given triangles
+    void build(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices);
+
+    void clear();
+
+    /**
+     * Feeds the triangles of all leaves touching the selection volume to
+     * SelectionTest::TestTriangles(). BeginMesh() needs to have been called
+     * with the same localToWorld transform.
+     */
+    void testSelect(const std::vector<MeshVertex>& vertices, SelectionTest& test,
+        const Matrix4& localToWorld, SelectionIntersection& best) const;
+
+    /**
+     * Finds the intersection of the given world space ray with the triangles
+     * which is closest to the ray origin. The ray is transformed into model
+     * space, the found intersection point is returned in world space.
+     */
+    bool getIntersection(const std::vector<MeshVertex>& vertices, const Ray& ray,
+        const Matrix4& localToWorld, Vector3& intersection) const;
+
+private:
+    // Creates the node for the given range of triangles and all of its children,
+    // returns the index of the created node
+    std::size_t buildNode(std::vector<Triangle>& triangles, std::size_t firstTriangle, std::size_t numTriangles);
+};
+
+}
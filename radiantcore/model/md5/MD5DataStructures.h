@@ -3,6 +3,7 @@
 #include <vector>
 #include "math/Vector3.h"
 #include "math/Quaternion.h"
+#include "MD5PoseCache.h"
 
 /** greebo: Some data structures used in MD5 model code
  */
@@ -77,6 +78,20 @@ struct MD5Weight
 
 typedef std::vector<MD5Weight> MD5Weights;
 
+/**
+ * The weights of a mesh in structure-of-arrays layout. Skinning runs over
+ * these contiguous arrays of plain numbers, which allows the compiler
+ * to vectorise the loop.
+ */
+struct MD5SkinningWeights
+{
+	std::vector<std::size_t> joint;
+	std::vector<double> t;
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> z;
+};
+
 // The combination of vertices, triangles and weighting information
 // represents our MD5 mesh - using this info it's possible to create
 // the actual rendered geometry (position, normals, etc.)
@@ -85,6 +100,12 @@ struct MD5Mesh
 	MD5Verts	vertices;
 	MD5Tris		triangles;
 	MD5Weights	weights;
+
+	// The weights in the layout used for skinning
+	MD5SkinningWeights skinningWeights;
+
+	// Recently calculated poses, shared by all instances of the mesh
+	MD5PoseCache poseCache;
 };
 typedef std::shared_ptr<MD5Mesh> MD5MeshPtr;
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include "imd5anim.h"
+#include "render/MeshVertex.h"
+#include "math/AABB.h"
+#include "MD5Skeleton.h"
+
+namespace md5
+{
+
+/**
+ * Keeps the vertices of the most recently calculated poses of an MD5 mesh.
+ *
+ * The cache belongs to the mesh, which is shared by all instances of the
+ * same model, so entities posed by the same animation frame only need
+ * to be skinned once. The entries keep their animation alive, such that
+ * the animation pointer in the pose stays unique.
+ */
+class MD5PoseCache
+{
+private:
+	// The number of poses kept per mesh
+	static constexpr std::size_t MaxEntries = 8;
+
+	struct Entry
+	{
+		MD5Skeleton::Pose pose;
+		IMD5AnimPtr anim;
+		std::vector<MeshVertex> vertices;
+		AABB bounds;
+	};
+
+	std::vector<Entry> _entries;
+
+	// The entry to be replaced next once the cache is full
+	std::size_t _nextEntry = 0;
+
+public:
+	// Copies the cached vertices and bounds of the given pose, returns false if not cached
+	bool get(const MD5Skeleton::Pose& pose, std::vector<MeshVertex>& vertices, AABB& bounds) const
+	{
+		for (const auto& entry : _entries)
+		{
+			if (entry.pose == pose)
+			{
+				vertices = entry.vertices;
+				bounds = entry.bounds;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void insert(const MD5Skeleton::Pose& pose, const IMD5AnimPtr& anim,
+		const std::vector<MeshVertex>& vertices, const AABB& bounds)
+	{
+		if (_entries.size() < MaxEntries)
+		{
+			_entries.emplace_back(Entry{ pose, anim, vertices, bounds });
+			return;
+		}
+
+		// Replace the oldest entry
+		_entries[_nextEntry] = Entry{ pose, anim, vertices, bounds };
+		_nextEntry = (_nextEntry + 1) % MaxEntries;
+	}
+
+	void clear()
+	{
+		_entries.clear();
+		_nextEntry = 0;
+	}
+};
+
+} // namespace
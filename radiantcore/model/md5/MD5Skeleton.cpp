@@ -91,6 +91,13 @@ void MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
 	std::size_t curFrame = static_cast<std::size_t>(std::floor(frameTime)) % _anim->getNumFrames();
 	std::size_t nextFrame = curFrame == _anim->getNumFrames() -1 ? curFrame : (curFrame + 1) % _anim->getNumFrames();
 
+	Pose pose{ _anim.get(), curFrame, nextFrame, nextFrameFrac };
+
+	// Playing animations are often requesting the same frame several times
+	if (pose == _pose) return;
+
+	_pose = pose;
+
 	// Apply the current frame keys to the base frame
 	for (std::size_t i = 0; i < numJoints; ++i)
 	{
@@ -13,6 +13,28 @@ namespace md5
  */
 class MD5Skeleton
 {
+public:
+	// Identifies the pose of the skeleton: the two frames of the
+	// animation and the blend factor between them
+	struct Pose
+	{
+		const IMD5Anim* anim = nullptr;
+		std::size_t curFrame = 0;
+		std::size_t nextFrame = 0;
+		float nextFrameFraction = 0;
+
+		bool operator==(const Pose& other) const
+		{
+			return anim == other.anim && curFrame == other.curFrame &&
+				nextFrame == other.nextFrame && nextFrameFraction == other.nextFrameFraction;
+		}
+
+		bool operator!=(const Pose& other) const
+		{
+			return !operator==(other);
+		}
+	};
+
 protected:
 	// The position and orientation of the animated joints at the current time
 	std::vector<IMD5Anim::Key> _skeleton;
@@ -20,10 +42,28 @@ protected:
 	// The current animation, needed to get joint information etc.
 	IMD5AnimPtr _anim;
 
+	Pose _pose;
+
 public:
-	// Update the skeleton to match the given animation at the given time
+	// Update the skeleton to match the given animation at the given time.
+	// Nothing is calculated if the skeleton is already in the requested pose.
 	void update(const IMD5AnimPtr& anim, std::size_t time);
 
+	const Pose& getPose() const
+	{
+		return _pose;
+	}
+
+	const IMD5AnimPtr& getAnim() const
+	{
+		return _anim;
+	}
+
+	const std::vector<IMD5Anim::Key>& getKeys() const
+	{
+		return _skeleton;
+	}
+
 	std::size_t size() const
 	{
 		return _skeleton.size();
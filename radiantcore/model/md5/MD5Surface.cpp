@@ -8,9 +8,19 @@
 namespace md5
 {
 
-inline VertexPointer vertexpointer_Meshvertex(const MeshVertex* array)
+namespace
 {
-  return VertexPointer(&array->vertex, sizeof(MeshVertex));
+	// Rotation and translation of a joint as 3x4 matrix, row by row
+	inline MD5Surface::JointTransform getJointTransform(const Quaternion& rotation, const Vector3& position)
+	{
+		auto r = Matrix4::getRotation(rotation);
+
+		return MD5Surface::JointTransform{{
+			r.xx(), r.yx(), r.zx(), position.x(),
+			r.xy(), r.yy(), r.zy(), position.y(),
+			r.xz(), r.yz(), r.zz(), position.z()
+		}};
+	}
 }
 
 // Constructor
@@ -28,6 +38,9 @@ MD5Surface::MD5Surface(const MD5Surface& other) :
 // Update geometry
 void MD5Surface::updateGeometry()
 {
+	// The vertices have been moved, rebuild the hierarchy on next use
+	_bvh.clear();
+
 	_aabb_local = AABB();
 
 	for (const auto& vertex : _vertices)
@@ -60,11 +73,9 @@ void MD5Surface::testSelect(Selector& selector,
 	test.BeginMesh(localToWorld);
 
 	SelectionIntersection best;
-	test.TestTriangles(
-	  vertexpointer_Meshvertex(_vertices.data()),
-	  IndexPointer(_indices.data(), IndexPointer::index_type(_indices.size())),
-	  best
-	);
+
+	// Only the triangles near the selection volume are tested
+	getBVH().testSelect(_vertices, test, localToWorld, best);
 
 	if(best.isValid()) {
 		selector.addIntersection(best);
@@ -73,43 +84,17 @@ void MD5Surface::testSelect(Selector& selector,
 
 bool MD5Surface::getIntersection(const Ray& ray, Vector3& intersection, const Matrix4& localToWorld)
 {
-	Vector3 bestIntersection = ray.origin;
-	Vector3 triIntersection;
+	return getBVH().getIntersection(_vertices, ray, localToWorld, intersection);
+}
 
-	for (Indices::const_iterator i = _indices.begin();
-		 i != _indices.end();
-		 i += 3)
+const model::TriangleBVH& MD5Surface::getBVH()
+{
+	if (_bvh.empty())
 	{
-		// Get the vertices for this triangle
-		const auto& p1 = _vertices[*(i)];
-		const auto& p2 = _vertices[*(i+1)];
-		const auto& p3 = _vertices[*(i+2)];
-
-		if (ray.intersectTriangle(localToWorld.transformPoint(p1.vertex),
-			localToWorld.transformPoint(p2.vertex), localToWorld.transformPoint(p3.vertex), triIntersection))
-		{
-			intersection = triIntersection;
-
-			// Test if this surface intersection is better than what we currently have
-			auto oldDistSquared = (bestIntersection - ray.origin).getLengthSquared();
-			auto newDistSquared = (triIntersection - ray.origin).getLengthSquared();
-
-			if ((oldDistSquared == 0 && newDistSquared > 0) || newDistSquared < oldDistSquared)
-			{
-				bestIntersection = triIntersection;
-			}
-		}
+		_bvh.build(_vertices, _indices);
 	}
 
-	if ((bestIntersection - ray.origin).getLengthSquared() > 0)
-	{
-		intersection = bestIntersection;
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	return _bvh;
 }
 
 void MD5Surface::setDefaultMaterial(const std::string& name)
@@ -182,43 +167,72 @@ const AABB& MD5Surface::getSurfaceBounds() const
 
 void MD5Surface::updateToDefaultPose(const MD5Joints& joints)
 {
-	if (_vertices.size() != _mesh->vertices.size())
+	std::vector<JointTransform> transforms;
+	transforms.reserve(joints.size());
+
+	for (const auto& joint : joints)
 	{
-		_vertices.resize(_mesh->vertices.size());
+		transforms.emplace_back(getJointTransform(joint.rotation, joint.position));
 	}
 
-	for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
-	{
-		MD5Vert& vert = _mesh->vertices[j];
+	// No longer in any animated pose
+	_pose = MD5Skeleton::Pose();
 
-		Vector3 skinned(0, 0, 0);
+	skinVertices(transforms);
 
-		for (std::size_t k = 0; k != vert.weight_count; ++k)
-		{
-			MD5Weight& weight = _mesh->weights[vert.weight_index + k];
-			const MD5Joint& joint = joints[weight.joint];
+	// Ensure the index array is ok
+	if (_indices.empty())
+	{
+		buildIndexArray();
+	}
 
-			Vector3 rotatedPoint = joint.rotation.transformPoint(weight.v);
-			skinned += (rotatedPoint + joint.position) * weight.t;
-		}
+	buildVertexNormals();
 
-		_vertices[j].vertex = skinned;
-		_vertices[j].texcoord = TexCoord2f(vert.u, vert.v);
-		_vertices[j].normal = Normal3(0,0,0);
+	updateGeometry();
+}
+
+void MD5Surface::updateToSkeleton(const MD5Skeleton& skeleton)
+{
+	// Nothing to do if this surface is in the requested pose already
+	if (_pose.anim != nullptr && _pose == skeleton.getPose())
+	{
+		return;
 	}
 
+	_pose = skeleton.getPose();
+
 	// Ensure the index array is ok
 	if (_indices.empty())
 	{
 		buildIndexArray();
 	}
 
+	// Other instances of this mesh might have calculated the pose already
+	if (_mesh->poseCache.get(_pose, _vertices, _aabb_local))
+	{
+		_bvh.clear();
+		return;
+	}
+
+	std::vector<JointTransform> transforms;
+	transforms.reserve(skeleton.size());
+
+	for (const auto& key : skeleton.getKeys())
+	{
+		transforms.emplace_back(getJointTransform(key.orientation, key.origin));
+	}
+
+	// Deform vertices to fit the skeleton
+	skinVertices(transforms);
+
 	buildVertexNormals();
 
 	updateGeometry();
+
+	_mesh->poseCache.insert(_pose, skeleton.getAnim(), _vertices, _aabb_local);
 }
 
-void MD5Surface::updateToSkeleton(const MD5Skeleton& skeleton)
+void MD5Surface::skinVertices(const std::vector<JointTransform>& joints)
 {
 	// Ensure we have all vertices allocated
 	if (_vertices.size() != _mesh->vertices.size())
@@ -226,37 +240,49 @@ void MD5Surface::updateToSkeleton(const MD5Skeleton& skeleton)
 		_vertices.resize(_mesh->vertices.size());
 	}
 
-	// Deform vertices to fit the skeleton
+	const auto& weights = _mesh->skinningWeights;
+	auto numWeights = weights.t.size();
+
+	// Transform all weight positions by their joint first, in one flat loop
+	std::vector<double> weighted(numWeights * 3);
+
+	auto* px = weighted.data();
+	auto* py = px + numWeights;
+	auto* pz = py + numWeights;
+
+	const auto* joint = weights.joint.data();
+	const auto* t = weights.t.data();
+	const auto* x = weights.x.data();
+	const auto* y = weights.y.data();
+	const auto* z = weights.z.data();
+
+	for (std::size_t i = 0; i < numWeights; ++i)
+	{
+		const auto& m = joints[joint[i]].m;
+
+		px[i] = (m[0] * x[i] + m[1] * y[i] + m[2] * z[i] + m[3]) * t[i];
+		py[i] = (m[4] * x[i] + m[5] * y[i] + m[6] * z[i] + m[7]) * t[i];
+		pz[i] = (m[8] * x[i] + m[9] * y[i] + m[10] * z[i] + m[11]) * t[i];
+	}
+
+	// Sum up the weighted positions of each vertex
 	for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
 	{
-		MD5Vert& vert = _mesh->vertices[j];
+		const MD5Vert& vert = _mesh->vertices[j];
 
-		Vector3 skinned(0, 0, 0);
+		double sx = 0, sy = 0, sz = 0;
 
-		for (std::size_t k = 0; k != vert.weight_count; ++k)
+		for (auto k = vert.weight_index; k < vert.weight_index + vert.weight_count; ++k)
 		{
-			MD5Weight& weight = _mesh->weights[vert.weight_index + k];
-			const IMD5Anim::Key& key = skeleton.getKey(weight.joint);
-			//const Joint& joint = skeleton.getJoint(weight.joint);
-
-			Vector3 rotatedPoint = key.orientation.transformPoint(weight.v);
-			skinned += (rotatedPoint + key.origin) * weight.t;
+			sx += px[k];
+			sy += py[k];
+			sz += pz[k];
 		}
 
-		_vertices[j].vertex = skinned;
+		_vertices[j].vertex = Vertex3(sx, sy, sz);
 		_vertices[j].texcoord = TexCoord2f(vert.u, vert.v);
 		_vertices[j].normal = Normal3(0,0,0);
 	}
-
-	// Ensure the index array is ok
-	if (_indices.empty())
-	{
-		buildIndexArray();
-	}
-
-	buildVertexNormals();
-
-	updateGeometry();
 }
 
 void MD5Surface::buildVertexNormals()
@@ -385,6 +411,24 @@ void MD5Surface::parseFromTokens(parser::DefTokeniser& tok)
 
 	} // for each weight
 
+	// Store the weights in the layout used for skinning
+	auto& skinningWeights = mesh.skinningWeights;
+
+	skinningWeights.joint.reserve(numWeights);
+	skinningWeights.t.reserve(numWeights);
+	skinningWeights.x.reserve(numWeights);
+	skinningWeights.y.reserve(numWeights);
+	skinningWeights.z.reserve(numWeights);
+
+	for (const auto& weight : weights)
+	{
+		skinningWeights.joint.push_back(weight.joint);
+		skinningWeights.t.push_back(weight.t);
+		skinningWeights.x.push_back(weight.v.x());
+		skinningWeights.y.push_back(weight.v.y());
+		skinningWeights.z.push_back(weight.v.z());
+	}
+
 	// ----- END OF MESH DECL -----
 
 	tok.assertNextToken("}");
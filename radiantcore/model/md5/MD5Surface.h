@@ -9,6 +9,8 @@
 #include "imodelsurface.h"
 
 #include "MD5DataStructures.h"
+#include "MD5Skeleton.h"
+#include "../TriangleBVH.h"
 #include "parser/DefTokeniser.h"
 
 class Ray;
@@ -16,8 +18,6 @@ class Ray;
 namespace md5
 {
 
-class MD5Skeleton;
-
 class MD5Surface final :
 	public model::IIndexedModelSurface
 {
@@ -25,6 +25,12 @@ public:
 	typedef std::vector<MeshVertex> Vertices;
 	typedef IndexBuffer Indices;
 
+	// The transform of a joint as 3x4 matrix, row by row
+	struct JointTransform
+	{
+		double m[12];
+	};
+
 private:
 	AABB _aabb_local;
 
@@ -42,6 +48,13 @@ private:
 	Vertices _vertices;
 	Indices _indices;
 
+	// The animation pose the vertices are in, anim is null if not animated
+	MD5Skeleton::Pose _pose;
+
+	// Triangle hierarchy of the current pose for selection and ray tests,
+	// built on first use
+	model::TriangleBVH _bvh;
+
 public:
 
 	MD5Surface();
@@ -97,6 +110,11 @@ public:
 private:
 	// Re-calculate the normal vectors
 	void buildVertexNormals();
+
+	// Calculates the vertex positions from the given joint transforms
+	void skinVertices(const std::vector<JointTransform>& joints);
+
+	const model::TriangleBVH& getBVH();
 };
 typedef std::shared_ptr<MD5Surface> MD5SurfacePtr;
 
@@ -43,6 +43,18 @@ PicoModelLoader::PicoModelLoader(const picoModule_t* module, const std::string&
 
 // Load the given model from the VFS path
 IModelPtr PicoModelLoader::loadModelFromPath(const std::string& path)
+{
+	auto model = parseModelFromPath(path);
+
+	if (model)
+	{
+		finishModelLoad(model);
+	}
+
+	return model;
+}
+
+IModelPtr PicoModelLoader::parseModelFromPath(const std::string& path)
 {
 	// Open an ArchiveFile to load
 	auto file = path_is_absolute(path.c_str()) ?
@@ -155,7 +167,33 @@ std::string PicoModelLoader::CleanupShaderName(const std::string& inName)
 	}
 }
 
-std::string PicoModelLoader::DetermineDefaultMaterial(picoSurface_t* picoSurface, const std::string& extension)
+void PicoModelLoader::finishModelLoad(const IModelPtr& model)
+{
+	auto staticModel = std::dynamic_pointer_cast<StaticModel>(model);
+
+	// #4644: Doom3 don't use the *MATERIAL_NAME in ASE models, only *BITMAP is used
+	// Use the fallback (introduced in #2499) only when the game allows it
+	if (!staticModel || !game::current::getValue<bool>("/modelFormat/ase/useMaterialNameIfNoBitmapFound"))
+	{
+		return;
+	}
+
+	for (const auto& s : staticModel->getSurfaces())
+	{
+		auto& surface = *s.surface;
+
+		// If shader not found, fallback to alternative if available
+		// The default material is empty if the ase material has no BITMAP
+		if (!surface.getFallbackMaterial().empty() && (surface.getDefaultMaterial().empty() ||
+			!GlobalMaterialManager().materialExists(surface.getDefaultMaterial())))
+		{
+			surface.setDefaultMaterial(surface.getFallbackMaterial());
+		}
+	}
+}
+
+void PicoModelLoader::DetermineDefaultMaterial(picoSurface_t* picoSurface, const std::string& extension,
+	StaticModelSurface& surface)
 {
 	// Get the shader from the picomodel struct. If this is a LWO model, use
 	// the material name to select the shader, while for an ASE model the
@@ -182,21 +220,14 @@ std::string PicoModelLoader::DetermineDefaultMaterial(picoSurface_t* picoSurface
 		}
 	}
 
-	// #4644: Doom3 don't use the *MATERIAL_NAME in ASE models, only *BITMAP is used
-	// Use the fallback (introduced in #2499) only when the game allows it
-	if (game::current::getValue<bool>("/modelFormat/ase/useMaterialNameIfNoBitmapFound"))
+	surface.setDefaultMaterial(defaultMaterial);
+
+	// Whether the ASE material name is used instead is decided by finishModelLoad(),
+	// this might be running on a worker thread
+	if (!rawName.empty())
 	{
-		// If shader not found, fallback to alternative if available
-		// _defaultMaterial is empty if the ase material has no BITMAP
-		// materialIsValid is false if _defaultMaterial is not an existing shader
-		if ((defaultMaterial.empty() || !GlobalMaterialManager().materialExists(defaultMaterial)) &&
-			!rawName.empty())
-		{
-			defaultMaterial = CleanupShaderName(rawName);
-		}
+		surface.setFallbackMaterial(CleanupShaderName(rawName));
 	}
-
-	return defaultMaterial;
 }
 
 StaticModelSurfacePtr PicoModelLoader::CreateSurface(picoSurface_t* picoSurface, const std::string& extension)
@@ -249,7 +280,7 @@ StaticModelSurfacePtr PicoModelLoader::CreateSurface(picoSurface_t* picoSurface,
 		staticSurface = std::make_shared<StaticModelSurface>(std::move(vertices), std::move(indices));
 	}
 
-	staticSurface->setDefaultMaterial(DetermineDefaultMaterial(picoSurface, extension));
+	DetermineDefaultMaterial(picoSurface, extension, *staticSurface);
 
 	return staticSurface;
 }
@@ -22,10 +22,17 @@ public:
 	// Load the given model from the path, VFS or absolute
 	IModelPtr loadModelFromPath(const std::string& name) override;
 
+	IModelPtr parseModelFromPath(const std::string& name) override;
+
+	// Applies the ASE material name fallback if the game is using it
+	void finishModelLoad(const IModelPtr& model) override;
+
 public:
 	static std::vector<StaticModelSurfacePtr> CreateSurfaces(picoModel_t* picoModel, const std::string& extension);
 
-	static std::string DetermineDefaultMaterial(picoSurface_t* picoSurface, const std::string& extension);
+	// Sets the default material of the surface, and the fallback material used by finishModelLoad()
+	static void DetermineDefaultMaterial(picoSurface_t* picoSurface, const std::string& extension,
+		StaticModelSurface& surface);
 	static std::string CleanupShaderName(const std::string& inName);
 
 private:
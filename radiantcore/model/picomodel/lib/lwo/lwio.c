@@ -25,7 +25,7 @@ read requests until flen is reset.
 #define INT_MIN     (-2147483647 - 1) /* minimum (signed) int value */
 #define FLEN_ERROR INT_MIN
 
-static int flen;
+static PICO_THREAD_LOCAL int flen;
 
 void set_flen( int i ) { flen = i; }
 
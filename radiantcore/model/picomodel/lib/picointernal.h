@@ -64,6 +64,13 @@ extern "C"
 	#define _pico_strnicmp strncasecmp
 #endif
 
+/* models can be loaded on several threads at once, loader state must not be shared */
+#if _MSC_VER
+	#define PICO_THREAD_LOCAL __declspec(thread)
+#else
+	#define PICO_THREAD_LOCAL __thread
+#endif
+
 
 /* constants */
 #define	PICO_PI	3.14159265358979323846
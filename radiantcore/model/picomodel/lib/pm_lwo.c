@@ -49,7 +49,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* helper functions */
 static const char *lwo_lwIDToStr( unsigned int lwID )
 {
-	static char lwIDStr[5];
+	static PICO_THREAD_LOCAL char lwIDStr[5];
 
 	if (!lwID)
 	{
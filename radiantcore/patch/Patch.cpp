@@ -50,6 +50,7 @@ Patch::Patch(PatchNode& node) :
 	_undoStateSaver(nullptr),
 	_transformChanged(false),
 	_tesselationChanged(true),
+	_tesselationPrepared(false),
 	_shader(texdef_name_default())
 {
 	construct();
@@ -65,6 +66,7 @@ Patch::Patch(const Patch& other, PatchNode& node) :
 	_undoStateSaver(nullptr),
 	_transformChanged(false),
 	_tesselationChanged(true),
+	_tesselationPrepared(false),
 	_shader(other._shader.getMaterialName())
 {
 	// Initalise the default values
@@ -234,6 +236,7 @@ void Patch::transformChanged()
 {
 	_transformChanged = true;
 	_tesselationChanged = true;
+	_tesselationPrepared = false;
 }
 
 // Called to evaluate the transform
@@ -373,6 +376,8 @@ PatchControl& Patch::getTransformedCtrlAt(std::size_t row, std::size_t col)
 // called just before an action to save the undo state
 void Patch::undoSave()
 {
+	_node.markChanged();
+
 	// Notify the undo observer to save this patch state
 	if (_undoStateSaver != NULL)
 	{
@@ -486,6 +491,9 @@ void Patch::updateTesselation(bool force)
 
 	_tesselationChanged = false;
 
+	auto prepared = _tesselationPrepared && !force;
+	_tesselationPrepared = false;
+
 	if (!isValid())
 	{
 		_mesh.clear();
@@ -493,14 +501,27 @@ void Patch::updateTesselation(bool force)
 		return;
 	}
 
-	// Run the tesselation code
-	_mesh.generate(_width, _height, _ctrlTransformed, subdivisionsFixed(), getSubdivisions(), _node.getRenderEntity());
+	// Run the tesselation code, unless prepareTesselation() already did
+	if (!prepared)
+	{
+		_mesh.generate(_width, _height, _ctrlTransformed, subdivisionsFixed(), getSubdivisions(), _node.getRenderEntity());
+	}
 
 	updateAABB();
 
 	_node.onTesselationChanged();
 }
 
+void Patch::prepareTesselation()
+{
+	// A pending transform needs to be evaluated by updateTesselation() first
+	if (!_tesselationChanged || _tesselationPrepared || _transformChanged || !isValid()) return;
+
+	_mesh.generate(_width, _height, _ctrlTransformed, subdivisionsFixed(), getSubdivisions(), _node.getRenderEntity());
+
+	_tesselationPrepared = true;
+}
+
 void Patch::invertMatrix()
 {
   undoSave();
@@ -2504,7 +2525,11 @@ void Patch::setFixedSubdivisions(bool isFixed, const Subdivisions& divisions)
 		_subDivisions.y() = 4;
 	}
 
-	SceneChangeNotify();
+	if (_node.inScene())
+	{
+		SceneChangeNotify();
+	}
+
 	textureChanged();
 	controlPointsChanged();
 }
@@ -2568,7 +2593,11 @@ void Patch::textureChanged()
 		(*i++)->onPatchTextureChanged();
 	}
 
-	signal_patchTextureChanged().emit();
+	// Patches outside the scene (e.g. constructed by a map loader thread) don't affect the UI
+	if (_node.inScene())
+	{
+		signal_patchTextureChanged().emit();
+	}
 }
 
 void Patch::attachObserver(Observer* observer)
@@ -2590,4 +2619,5 @@ sigc::signal<void>& Patch::signal_patchTextureChanged()
 void Patch::queueTesselationUpdate()
 {
 	_tesselationChanged = true;
+	_tesselationPrepared = false;
 }
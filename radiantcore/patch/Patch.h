@@ -58,6 +58,9 @@ class Patch :
 	// TRUE if the patch tesselation needs an update
 	bool _tesselationChanged;
 
+	// TRUE if the mesh has already been generated by prepareTesselation()
+	bool _tesselationPrepared;
+
 	// The rendersystem we're attached to, to acquire materials
 	RenderSystemWeakPtr _renderSystem;
 
@@ -326,6 +329,10 @@ public:
 	static sigc::signal<void>& signal_patchTextureChanged();
 
 	void updateTesselation(bool force = false) override;
+
+	// Generates the pending tesselation ahead of updateTesselation(), touching nothing
+	// but the patch itself. Safe to call for different patches on several threads.
+	void prepareTesselation();
 	void queueTesselationUpdate();
 
 private:
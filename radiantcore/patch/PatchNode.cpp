@@ -5,7 +5,7 @@
 #include "iradiant.h"
 #include "icounter.h"
 #include "math/Frustum.h"
-#include "math/Hash.h"
+#include "math/FastHash.h"
 
 PatchNode::PatchNode(patch::PatchDefType type) :
 	scene::SelectableNode(),
@@ -46,16 +46,16 @@ scene::INode::Type PatchNode::getNodeType() const
 	return Type::Patch;
 }
 
-std::string PatchNode::getFingerprint()
+scene::Fingerprint PatchNode::getFingerprint()
 {
 	constexpr std::size_t SignificantDigits = scene::SignificantFingerprintDoubleDigits;
 
 	if (m_patch.getHeight() * m_patch.getWidth() == 0)
 	{
-		return std::string(); // empty patches produce an empty fingerprint
+		return scene::Fingerprint(); // empty patches produce an empty fingerprint
 	}
 
-	math::Hash hash;
+	math::FastHash hash;
 
 	// Width & Height
 	hash.addSizet(m_patch.getHeight());
@@ -346,6 +346,12 @@ bool PatchNode::getIntersection(const Ray& ray, Vector3& intersection)
 	return m_patch.getIntersection(ray, intersection);
 }
 
+void PatchNode::onPreRenderLocal(const VolumeTest& volume)
+{
+	// The expensive part of the tesselation can be done ahead of onPreRender
+	m_patch.prepareTesselation();
+}
+
 void PatchNode::onPreRender(const VolumeTest& volume)
 {
 	// Defer the tesselation calculation to the last minute
@@ -61,7 +61,7 @@ public:
 	Type getNodeType() const override;
 
 	// IComparableNode implementation
-	std::string getFingerprint() override;
+	scene::Fingerprint getFingerprint() override;
 
 	// Bounded implementation
 	const AABB& localAABB() const override;
@@ -126,6 +126,7 @@ public:
 	// Render functions, these make sure that all things get rendered properly. The calls are also passed on
 	// to the contained patch <m_patch>
 	void onPreRender(const VolumeTest& volume) override;
+	void onPreRenderLocal(const VolumeTest& volume) override;
 	void renderHighlights(IRenderableCollector& collector, const VolumeTest& volume) override;
 	void setRenderSystem(const RenderSystemPtr& renderSystem) override;
 
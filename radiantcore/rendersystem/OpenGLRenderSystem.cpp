@@ -187,6 +187,9 @@ void OpenGLRenderSystem::startFrame()
 {
 	// Prepare the storage objects
 	_geometryStore.onFrameStart();
+
+	// Textures loaded in the background are ready to be used in this frame
+	GlobalMaterialManager().uploadPendingTextures();
 }
 
 void OpenGLRenderSystem::endFrame()
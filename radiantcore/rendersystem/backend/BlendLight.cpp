@@ -19,49 +19,47 @@ bool BlendLight::isInView(const IRenderView& view)
     return view.TestAABB(_lightBounds) != VOLUME_OUTSIDE;
 }
 
-void BlendLight::collectSurfaces(const IRenderView& view, const std::set<IRenderEntityPtr>& entities)
+void BlendLight::collectSurfaces(const IRenderView& view, const RenderableSpatialIndex& renderables)
 {
-    // Now check all the entities intersecting with this light
-    for (const auto& entity : entities)
+    // Now check all the objects intersecting with this light
+    renderables.foreachEntryTouchingBounds(_lightBounds, [&](const RenderableSpatialIndex::Entry& entry)
     {
-        entity->foreachRenderableTouchingBounds(_lightBounds,
-            [&](const IRenderableObject::Ptr& object, Shader* shader)
-        {
-            // Skip empty objects and invisible surfaces
-            if (!object->isVisible() || !shader->isVisible()) return;
+        auto& object = *entry.object;
 
-            // Cull surfaces that are not in view
-            if (object->isOriented())
-            {
-                if (view.TestAABB(object->getObjectBounds(), object->getObjectTransform()) == VOLUME_OUTSIDE)
-                {
-                    return;
-                }
-            }
-            else if (view.TestAABB(object->getObjectBounds()) == VOLUME_OUTSIDE) // non-oriented AABB test
+        // Skip empty objects and invisible surfaces
+        if (!object.isVisible() || !entry.shader->isVisible()) return;
+
+        // Cull surfaces that are not in view
+        if (object.isOriented())
+        {
+            if (view.TestAABB(object.getObjectBounds(), object.getObjectTransform()) == VOLUME_OUTSIDE)
             {
                 return;
             }
+        }
+        else if (view.TestAABB(object.getObjectBounds()) == VOLUME_OUTSIDE) // non-oriented AABB test
+        {
+            return;
+        }
 
-            auto glShader = static_cast<OpenGLShader*>(shader);
+        auto glShader = static_cast<OpenGLShader*>(entry.shader);
 
-            // We only consider materials designated for camera rendering
-            if (!glShader->isApplicableTo(RenderViewType::Camera))
-            {
-                return;
-            }
+        // We only consider materials designated for camera rendering
+        if (!glShader->isApplicableTo(RenderViewType::Camera))
+        {
+            return;
+        }
 
-            // Blend lights only affect materials that interact with lighting
-            if (!glShader->getInteractionPass())
-            {
-                return;
-            }
+        // Blend lights only affect materials that interact with lighting
+        if (!glShader->getInteractionPass())
+        {
+            return;
+        }
 
-            _objects.emplace_back(std::ref(*object));
+        _objects.emplace_back(std::ref(object));
 
-            ++_objectCount;
-        });
-    }
+        ++_objectCount;
+    });
 }
 
 void BlendLight::draw(OpenGLState& state, RenderStateFlags globalFlagsMask, 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "irender.h"
+#include "RenderableSpatialIndex.h"
 
 namespace render
 {
@@ -37,7 +38,7 @@ public:
     BlendLight(BlendLight&& other) = default;
 
     bool isInView(const IRenderView& view);
-    void collectSurfaces(const IRenderView& view, const std::set<IRenderEntityPtr>& entities);
+    void collectSurfaces(const IRenderView& view, const RenderableSpatialIndex& renderables);
 
     std::size_t getObjectCount() const
     {
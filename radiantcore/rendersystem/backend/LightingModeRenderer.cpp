@@ -111,6 +111,7 @@ IRenderResult::Ptr LightingModeRenderer::render(RenderStateFlags globalFlagsMask
     _regularLights.clear();
     _nearestShadowLights.clear();
     _blendLights.clear();
+    _renderables.clear();
 
     return std::move(_result); // move-return our result reference
 }
@@ -119,6 +120,9 @@ void LightingModeRenderer::collectLights(const IRenderView& view)
 {
     _regularLights.reserve(_lights.size());
 
+    // Index the entity renderables once, rather than letting every light check all of them
+    _renderables.build(_entities);
+
     // Categorise all visible lights
     for (const auto& light : _lights)
     {
@@ -151,7 +155,7 @@ void LightingModeRenderer::collectRegularLight(RendererLight& light, const IRend
     }
 
     // Check all the surfaces that are touching this light
-    interaction.collectSurfaces(view, _entities);
+    interaction.collectSurfaces(view, _renderables);
 
     _result->visibleLights++;
     _result->objects += interaction.getObjectCount();
@@ -178,7 +182,7 @@ void LightingModeRenderer::collectBlendLight(RendererLight& light, const IRender
     }
 
     // Check all the surfaces that are touching this light
-    blendLight.collectSurfaces(view, _entities);
+    blendLight.collectSurfaces(view, _renderables);
 
     _result->visibleLights++;
     _result->objects += blendLight.getObjectCount();
@@ -11,6 +11,7 @@
 #include "glprogram/BlendLightProgram.h"
 #include "RegularLight.h"
 #include "BlendLight.h"
+#include "RenderableSpatialIndex.h"
 #include "registry/CachedKey.h"
 
 namespace render
@@ -51,6 +52,9 @@ private:
     std::vector<RegularLight*> _nearestShadowLights;
     std::vector<BlendLight> _blendLights;
 
+    // All entity renderables, shared by the lights collecting their surfaces
+    RenderableSpatialIndex _renderables;
+
     std::shared_ptr<LightingModeRenderResult> _result;
 
 public:
@@ -48,55 +48,53 @@ bool RegularLight::isShadowCasting() const
     return _isShadowCasting;
 }
 
-void RegularLight::collectSurfaces(const IRenderView& view, const std::set<IRenderEntityPtr>& entities)
+void RegularLight::collectSurfaces(const IRenderView& view, const RenderableSpatialIndex& renderables)
 {
     bool shadowCasting = isShadowCasting();
 
-    // Now check all the entities intersecting with this light
-    for (const auto& entity : entities)
+    // Now check all the objects intersecting with this light
+    renderables.foreachEntryTouchingBounds(_lightBounds, [&](const RenderableSpatialIndex::Entry& entry)
     {
-        entity->foreachRenderableTouchingBounds(_lightBounds,
-            [&](const IRenderableObject::Ptr& object, Shader* shader)
-        {
-            // Skip empty objects
-            if (!object->isVisible()) return;
+        auto& object = *entry.object;
+
+        // Skip empty objects
+        if (!object.isVisible()) return;
 
-            // Don't collect invisible shaders
-            if (!shader->isVisible()) return;
+        // Don't collect invisible shaders
+        if (!entry.shader->isVisible()) return;
 
-            // For non-shadow lights we can cull surfaces that are not in view
-            if (!shadowCasting)
+        // For non-shadow lights we can cull surfaces that are not in view
+        if (!shadowCasting)
+        {
+            if (object.isOriented())
             {
-                if (object->isOriented())
-                {
-                    if (view.TestAABB(object->getObjectBounds(), object->getObjectTransform()) == VOLUME_OUTSIDE)
-                    {
-                        return;
-                    }
-                }
-                else if (view.TestAABB(object->getObjectBounds()) == VOLUME_OUTSIDE) // non-oriented AABB test
+                if (view.TestAABB(object.getObjectBounds(), object.getObjectTransform()) == VOLUME_OUTSIDE)
                 {
                     return;
                 }
             }
-
-            auto glShader = static_cast<OpenGLShader*>(shader);
-
-            // We only consider materials designated for camera rendering
-            if (!glShader->isApplicableTo(RenderViewType::Camera))
+            else if (view.TestAABB(object.getObjectBounds()) == VOLUME_OUTSIDE) // non-oriented AABB test
             {
                 return;
             }
+        }
 
-            // Collect all interaction surfaces and the ones with forceShadows materials
-            if (!glShader->getInteractionPass() && (!shader->getMaterial() || !shader->getMaterial()->surfaceCastsShadow()))
-            {
-                return; // This material doesn't interact with this light
-            }
+        auto glShader = static_cast<OpenGLShader*>(entry.shader);
 
-            addObject(*object, *entity, glShader);
-        });
-    }
+        // We only consider materials designated for camera rendering
+        if (!glShader->isApplicableTo(RenderViewType::Camera))
+        {
+            return;
+        }
+
+        // Collect all interaction surfaces and the ones with forceShadows materials
+        if (!glShader->getInteractionPass() && (!entry.shader->getMaterial() || !entry.shader->getMaterial()->surfaceCastsShadow()))
+        {
+            return; // This material doesn't interact with this light
+        }
+
+        addObject(object, *entry.entity, glShader);
+    });
 }
 
 void RegularLight::fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& program,
@@ -9,6 +9,7 @@
 #include "irenderview.h"
 #include "render/Rectangle.h"
 #include "InteractionPass.h"
+#include "RenderableSpatialIndex.h"
 
 namespace render
 {
@@ -179,7 +180,7 @@ public:
 
     bool isShadowCasting() const;
 
-    void collectSurfaces(const IRenderView& view, const std::set<IRenderEntityPtr>& entities);
+    void collectSurfaces(const IRenderView& view, const RenderableSpatialIndex& renderables);
 
     void fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& program,
         std::size_t renderTime, std::vector<IGeometryStore::Slot>& untransformedObjectsWithoutAlphaTest);
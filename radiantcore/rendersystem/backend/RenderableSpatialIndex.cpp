@@ -0,0 +1,93 @@
+#include "RenderableSpatialIndex.h"
+
+#include <algorithm>
+
+namespace render
+{
+
+namespace
+{
+    // Nodes with up to this many entries are not split any further
+    constexpr std::size_t MAX_ENTRIES_PER_LEAF = 8;
+
+    inline AABB getWorldBounds(IRenderableObject& object)
+    {
+        return object.isOriented() ?
+            AABB::createFromOrientedAABBSafe(object.getObjectBounds(), object.getObjectTransform()) :
+            object.getObjectBounds();
+    }
+}
+
+void RenderableSpatialIndex::build(const std::set<IRenderEntityPtr>& entities)
+{
+    clear();
+
+    for (const auto& entity : entities)
+    {
+        entity->foreachRenderable([&](const IRenderableObject::Ptr& object, Shader* shader)
+        {
+            _entries.push_back(Entry{ getWorldBounds(*object), object.get(), entity.get(), shader });
+        });
+    }
+
+    if (_entries.empty()) return;
+
+    _nodes.reserve(2 * _entries.size() / MAX_ENTRIES_PER_LEAF + 1);
+
+    buildNode(0, _entries.size());
+}
+
+void RenderableSpatialIndex::clear()
+{
+    _entries.clear();
+    _nodes.clear();
+}
+
+std::size_t RenderableSpatialIndex::buildNode(std::size_t firstEntry, std::size_t numEntries)
+{
+    auto nodeIndex = _nodes.size();
+    _nodes.emplace_back(Node{ AABB(), firstEntry, numEntries, 0 });
+
+    auto begin = _entries.begin() + firstEntry;
+    auto end = begin + numEntries;
+
+    AABB bounds;
+    AABB centres;
+
+    for (auto i = begin; i != end; ++i)
+    {
+        bounds.includeAABB(i->bounds);
+        centres.includePoint(i->bounds.getOrigin());
+    }
+
+    _nodes[nodeIndex].bounds = bounds;
+
+    if (numEntries <= MAX_ENTRIES_PER_LEAF) return nodeIndex;
+
+    // Split the entries at the median along the axis their centres are spread the most
+    const auto& extents = centres.getExtents();
+    auto axis = extents.x() >= extents.y() ?
+        (extents.x() >= extents.z() ? 0 : 2) :
+        (extents.y() >= extents.z() ? 1 : 2);
+
+    // No point in splitting entries sharing the same centre
+    if (extents[axis] <= 0) return nodeIndex;
+
+    auto half = numEntries / 2;
+
+    std::nth_element(begin, begin + half, end, [&](const Entry& a, const Entry& b)
+    {
+        return a.bounds.getOrigin()[axis] < b.bounds.getOrigin()[axis];
+    });
+
+    _nodes[nodeIndex].numEntries = 0;
+
+    buildNode(firstEntry, half);
+    auto secondChild = buildNode(firstEntry + half, numEntries - half);
+
+    _nodes[nodeIndex].secondChild = secondChild;
+
+    return nodeIndex;
+}
+
+}
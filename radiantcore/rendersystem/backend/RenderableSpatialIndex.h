@@ -0,0 +1,108 @@
+#pragma once
+
+#include <set>
+#include <vector>
+#include "irender.h"
+#include "irenderableobject.h"
+#include "math/AABB.h"
+
+namespace render
+{
+
+/**
+ * Bounding volume hierarchy of all entity renderables in the scene.
+ *
+ * It is built once at the beginning of a lighting mode render pass and shared
+ * by all lights looking for the surfaces they interact with, instead of every
+ * light checking every renderable of every entity.
+ *
+ * Like the light interaction lists, the index lives through the course of
+ * a single render pass only and uses plain pointers.
+ */
+class RenderableSpatialIndex
+{
+public:
+    struct Entry
+    {
+        // Bounds of the object in world space
+        AABB bounds;
+
+        IRenderableObject* object;
+        IRenderEntity* entity;
+        Shader* shader;
+    };
+
+private:
+    struct Node
+    {
+        // Bounds of all entries below this node
+        AABB bounds;
+
+        // Leaf nodes refer to a range of entries, inner nodes have an entry count
+        // of 0. The first child of an inner node is stored right after it.
+        std::size_t firstEntry;
+        std::size_t numEntries;
+        std::size_t secondChild;
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<Node> _nodes;
+
+public:
+    // (Re-)builds the index from the renderables of the given entities
+    void build(const std::set<IRenderEntityPtr>& entities);
+
+    // Removes all entries, the allocated memory is kept for the next pass
+    void clear();
+
+    std::size_t getNumEntries() const
+    {
+        return _entries.size();
+    }
+
+    /**
+     * Invokes the functor for every entry whose bounds intersect the given
+     * world space bounds. The signature is void(const Entry& entry).
+     */
+    template<typename Functor>
+    void foreachEntryTouchingBounds(const AABB& bounds, const Functor& functor) const
+    {
+        if (_nodes.empty()) return;
+
+        // The tree is balanced, its depth is logarithmic in the number of entries
+        std::size_t stack[64];
+        std::size_t stackSize = 0;
+
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const auto& node = _nodes[stack[--stackSize]];
+
+            if (!node.bounds.intersects(bounds)) continue;
+
+            if (node.numEntries > 0)
+            {
+                for (auto i = node.firstEntry; i < node.firstEntry + node.numEntries; ++i)
+                {
+                    if (_entries[i].bounds.intersects(bounds))
+                    {
+                        functor(_entries[i]);
+                    }
+                }
+
+                continue;
+            }
+
+            stack[stackSize++] = node.secondChild;
+            stack[stackSize++] = static_cast<std::size_t>(&node - _nodes.data()) + 1;
+        }
+    }
+
+private:
+    // Creates the node for the given range of entries and all of its children,
+    // returns the index of the created node
+    std::size_t buildNode(std::size_t firstEntry, std::size_t numEntries);
+};
+
+}
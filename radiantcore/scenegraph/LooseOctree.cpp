@@ -0,0 +1,322 @@
+#include "LooseOctree.h"
+
+#include <algorithm>
+#include "inode.h"
+#include "ivolumetest.h"
+
+namespace scene
+{
+
+namespace
+{
+	const double MAX_WORLD_COORD = 65536;
+
+	// Cells are not subdivided any further below this size
+	const double MIN_CELL_EXTENTS = 128;
+
+	// The root cell is at 65536 extents, halving it down to 128
+	// results in a maximum tree depth of 10. Each level adds at most
+	// 7 entries to the depth-first traversal stack.
+	const std::size_t MAX_TRAVERSAL_STACK = 128;
+
+	const std::uint32_t ROOT_CELL = 0;
+
+	// Immutable ISPNode used to expose a snapshot of the tree structure
+	class SnapshotNode :
+		public ISPNode
+	{
+	public:
+		AABB bounds;
+		ISPNodeWeakPtr parent;
+		NodeList children;
+		MemberList members;
+
+		ISPNodePtr getParent() const override
+		{
+			return parent.lock();
+		}
+
+		const AABB& getBounds() const override
+		{
+			return bounds;
+		}
+
+		const NodeList& getChildNodes() const override
+		{
+			return children;
+		}
+
+		bool isLeaf() const override
+		{
+			return children.empty();
+		}
+
+		const MemberList& getMembers() const override
+		{
+			return members;
+		}
+	};
+}
+
+LooseOctree::LooseOctree()
+{
+	_cells.emplace_back();
+	_cells[ROOT_CELL].bounds = AABB(Vector3(0, 0, 0), Vector3(MAX_WORLD_COORD, MAX_WORLD_COORD, MAX_WORLD_COORD));
+}
+
+LooseOctree::~LooseOctree()
+{
+	// Nodes which are still linked need to forget about us, unless they
+	// have been linked into another partition in the meantime
+	for (const Cell& cell : _cells)
+	{
+		for (const INodePtr& member : cell.members)
+		{
+			SpacePartitionSlot& slot = member->getSpacePartitionSlot();
+
+			if (slot.owner == this)
+			{
+				slot = SpacePartitionSlot();
+			}
+		}
+	}
+}
+
+void LooseOctree::link(const INodePtr& sceneNode)
+{
+	// Take a copy, evaluating the bounds might end up calling back into the scenegraph
+	AABB bounds = sceneNode->worldAABB();
+
+	SpacePartitionSlot& slot = sceneNode->getSpacePartitionSlot();
+
+	// Make sure we don't do double-links
+	assert(slot.owner != this);
+
+	auto cellIndex = findTargetCell(bounds);
+	auto& members = _cells[cellIndex].members;
+
+	slot.owner = this;
+	slot.cell = cellIndex;
+	slot.index = members.size();
+
+	members.push_back(sceneNode);
+
+	for (auto i = cellIndex; i != INVALID_INDEX; i = _cells[i].parent)
+	{
+		++_cells[i].subtreeMembers;
+	}
+}
+
+bool LooseOctree::unlink(const INodePtr& sceneNode)
+{
+	SpacePartitionSlot& slot = sceneNode->getSpacePartitionSlot();
+
+	if (slot.owner != this)
+	{
+		return false;
+	}
+
+	auto cellIndex = static_cast<std::uint32_t>(slot.cell);
+	auto& members = _cells[cellIndex].members;
+
+	assert(slot.index < members.size() && members[slot.index] == sceneNode);
+
+	// Fill the gap with the last member of this cell
+	if (slot.index + 1 != members.size())
+	{
+		members[slot.index] = std::move(members.back());
+		members[slot.index]->getSpacePartitionSlot().index = slot.index;
+	}
+
+	members.pop_back();
+	slot = SpacePartitionSlot();
+
+	// Update the member counts up to the root, remembering the topmost empty cell
+	auto topmostEmptyCell = INVALID_INDEX;
+
+	for (auto i = cellIndex; i != INVALID_INDEX; i = _cells[i].parent)
+	{
+		if (--_cells[i].subtreeMembers == 0)
+		{
+			topmostEmptyCell = i;
+		}
+	}
+
+	if (topmostEmptyCell != INVALID_INDEX)
+	{
+		releaseChildBlock(topmostEmptyCell);
+	}
+
+	return true;
+}
+
+ISPNodePtr LooseOctree::getRoot() const
+{
+	return createSnapshot(ROOT_CELL, ISPNodePtr());
+}
+
+bool LooseOctree::foreachMemberInVolume(const VolumeTest& volume, const MemberVisitor& visitor)
+{
+	// Depth-first traversal without recursion. Cells are accessed through their
+	// index, a visitor linking new nodes might cause the pool to be re-allocated.
+	std::uint32_t stack[MAX_TRAVERSAL_STACK];
+	std::size_t stackSize = 0;
+
+	stack[stackSize++] = ROOT_CELL;
+
+	while (stackSize > 0)
+	{
+		auto cellIndex = stack[--stackSize];
+
+		for (std::size_t i = 0; i < _cells[cellIndex].members.size(); ++i)
+		{
+			if (!visitor(_cells[cellIndex].members[i]))
+			{
+				return false;
+			}
+		}
+
+		auto firstChild = _cells[cellIndex].firstChild;
+
+		if (firstChild == INVALID_INDEX) continue;
+
+		// Push the children in reverse order, such that the first child is visited first
+		for (std::uint32_t i = 8; i-- > 0;)
+		{
+			auto child = firstChild + i;
+			const Cell& cell = _cells[child];
+
+			// Empty subtrees can be skipped without any volume test
+			if (cell.subtreeMembers == 0) continue;
+
+			if (volume.TestAABB(AABB(cell.bounds.origin, cell.bounds.extents * 2)) == VOLUME_OUTSIDE)
+			{
+				continue;
+			}
+
+			assert(stackSize < MAX_TRAVERSAL_STACK);
+			stack[stackSize++] = child;
+		}
+	}
+
+	return true;
+}
+
+std::uint32_t LooseOctree::findTargetCell(const AABB& bounds)
+{
+	// Invalid bounds and nodes outside the world end up in the root
+	if (!bounds.isValid() || !_cells[ROOT_CELL].bounds.intersects(bounds.origin))
+	{
+		return ROOT_CELL;
+	}
+
+	double size = std::max(bounds.extents.x(), std::max(bounds.extents.y(), bounds.extents.z()));
+
+	auto cellIndex = ROOT_CELL;
+
+	while (true)
+	{
+		double childExtents = _cells[cellIndex].bounds.extents.x() * 0.5;
+
+		// Stop if the node doesn't fit into the loose bounds of the child
+		if (childExtents < MIN_CELL_EXTENTS || size > childExtents)
+		{
+			return cellIndex;
+		}
+
+		if (_cells[cellIndex].firstChild == INVALID_INDEX)
+		{
+			allocateChildBlock(cellIndex);
+		}
+
+		// Pick the octant containing the center of the bounds
+		const Vector3& origin = _cells[cellIndex].bounds.origin;
+
+		std::uint32_t octant =
+			(bounds.origin.x() >= origin.x() ? 1 : 0) |
+			(bounds.origin.y() >= origin.y() ? 2 : 0) |
+			(bounds.origin.z() >= origin.z() ? 4 : 0);
+
+		cellIndex = _cells[cellIndex].firstChild + octant;
+	}
+}
+
+void LooseOctree::allocateChildBlock(std::uint32_t parentIndex)
+{
+	std::uint32_t firstChild;
+
+	if (!_freeBlocks.empty())
+	{
+		firstChild = _freeBlocks.back();
+		_freeBlocks.pop_back();
+	}
+	else
+	{
+		firstChild = static_cast<std::uint32_t>(_cells.size());
+		_cells.resize(_cells.size() + 8);
+	}
+
+	// Each child has half the extents of the parent
+	Vector3 childExtents = _cells[parentIndex].bounds.extents * 0.5;
+	Vector3 parentOrigin = _cells[parentIndex].bounds.origin;
+
+	for (std::uint32_t i = 0; i < 8; ++i)
+	{
+		Cell& child = _cells[firstChild + i];
+
+		Vector3 offset(
+			(i & 1) ? childExtents.x() : -childExtents.x(),
+			(i & 2) ? childExtents.y() : -childExtents.y(),
+			(i & 4) ? childExtents.z() : -childExtents.z()
+		);
+
+		child.bounds = AABB(parentOrigin + offset, childExtents);
+		child.parent = parentIndex;
+		child.firstChild = INVALID_INDEX;
+		child.subtreeMembers = 0;
+
+		assert(child.members.empty());
+	}
+
+	_cells[parentIndex].firstChild = firstChild;
+}
+
+void LooseOctree::releaseChildBlock(std::uint32_t cellIndex)
+{
+	auto firstChild = _cells[cellIndex].firstChild;
+
+	if (firstChild == INVALID_INDEX) return;
+
+	assert(_cells[cellIndex].subtreeMembers == 0);
+
+	for (std::uint32_t i = 0; i < 8; ++i)
+	{
+		releaseChildBlock(firstChild + i);
+	}
+
+	_cells[cellIndex].firstChild = INVALID_INDEX;
+	_freeBlocks.push_back(firstChild);
+}
+
+ISPNodePtr LooseOctree::createSnapshot(std::uint32_t cellIndex, const ISPNodePtr& parent) const
+{
+	const Cell& cell = _cells[cellIndex];
+
+	auto node = std::make_shared<SnapshotNode>();
+
+	node->bounds = cell.bounds;
+	node->parent = parent;
+	node->members.assign(cell.members.begin(), cell.members.end());
+
+	if (cell.firstChild != INVALID_INDEX)
+	{
+		for (std::uint32_t i = 0; i < 8; ++i)
+		{
+			node->children.push_back(createSnapshot(cell.firstChild + i, node));
+		}
+	}
+
+	return node;
+}
+
+} // namespace scene
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "ispacepartition.h"
+#include "math/AABB.h"
+
+namespace scene
+{
+
+/**
+ * A loose octree keeping all of its cells in a single contiguous pool.
+ *
+ * Unlike the regular Octree the extents of this tree are fixed (covering the
+ * whole world coordinate range) and each cell accepts members which stick out
+ * of its bounds by up to half the cell size - the "loose" bounds of a cell are
+ * twice as large as its actual bounds. This way the target cell of a scene node
+ * can be determined by looking at its center and size alone, there is no need
+ * to test the node bounds against every child, and no re-distribution of members
+ * is ever necessary.
+ *
+ * Cells are addressed by index, the 8 children of a cell are allocated as one
+ * consecutive block, blocks of empty subtrees are recycled. The location of each
+ * linked scene node is stored in its SpacePartitionSlot, which makes unlink()
+ * a constant-time operation without any lookup table.
+ *
+ * The ISPNode hierarchy returned by getRoot() is a snapshot generated on demand,
+ * meant to be used for debug visualisation only.
+ */
+class LooseOctree final :
+	public ISpacePartitionSystem
+{
+private:
+	static constexpr std::uint32_t INVALID_INDEX = UINT32_MAX;
+
+	struct Cell
+	{
+		// The tight bounds of this cell, the loose bounds have twice the extents
+		AABB bounds;
+
+		std::uint32_t parent = INVALID_INDEX;
+
+		// Index of the first of the 8 consecutive child cells
+		std::uint32_t firstChild = INVALID_INDEX;
+
+		// Number of members linked to this cell and all its descendants
+		std::size_t subtreeMembers = 0;
+
+		std::vector<INodePtr> members;
+	};
+
+	// The cell pool, the root cell is always at index 0
+	std::vector<Cell> _cells;
+
+	// Released child blocks, ready for re-use
+	std::vector<std::uint32_t> _freeBlocks;
+
+public:
+	LooseOctree();
+
+	~LooseOctree();
+
+	void link(const INodePtr& sceneNode) override;
+	bool unlink(const INodePtr& sceneNode) override;
+
+	// Returns a snapshot of the current tree structure
+	ISPNodePtr getRoot() const override;
+
+	bool foreachMemberInVolume(const VolumeTest& volume, const MemberVisitor& visitor) override;
+
+private:
+	// Returns the smallest cell able to host an object with the given bounds,
+	// allocating child cells on the way down if necessary
+	std::uint32_t findTargetCell(const AABB& bounds);
+
+	void allocateChildBlock(std::uint32_t parentIndex);
+	void releaseChildBlock(std::uint32_t cellIndex);
+
+	ISPNodePtr createSnapshot(std::uint32_t cellIndex, const ISPNodePtr& parent) const;
+};
+
+} // namespace scene
@@ -1,6 +1,7 @@
 #include "Octree.h"
 
 #include "inode.h"
+#include "ivolumetest.h"
 
 #include "OctreeNode.h"
 
@@ -126,6 +127,47 @@ ISPNodePtr Octree::getRoot() const
 	return _root;
 }
 
+bool Octree::foreachMemberInVolume(const VolumeTest& volume, const MemberVisitor& visitor)
+{
+	return foreachMemberInVolume_r(*_root, volume, visitor);
+}
+
+bool Octree::foreachMemberInVolume_r(const ISPNode& node, const VolumeTest& volume, const MemberVisitor& visitor)
+{
+	// Visit all members
+	const ISPNode::MemberList& members = node.getMembers();
+
+	for (ISPNode::MemberList::const_iterator m = members.begin();
+		 m != members.end(); /* in-loop increment */)
+	{
+		// We're done, as soon as the walker returns FALSE
+		if (!visitor(*m++))
+		{
+			return false;
+		}
+	}
+
+	// Now consider the children
+	const ISPNode::NodeList& children = node.getChildNodes();
+
+	for (ISPNode::NodeList::const_iterator i = children.begin(); i != children.end(); ++i)
+	{
+		if (volume.TestAABB((*i)->getBounds()) == VOLUME_OUTSIDE)
+		{
+			continue; // Skip this node, not visible
+		}
+
+		// Traverse all the children too, enter recursion
+		if (!foreachMemberInVolume_r(**i, volume, visitor))
+		{
+			// The walker returned false somewhere in the recursion depths, propagate this message
+			return false;
+		}
+	}
+
+	return true; // continue traversal
+}
+
 void Octree::notifyLink(const scene::INodePtr& sceneNode, OctreeNode* node)
 {
 	std::pair<NodeMapping::iterator, bool> result =
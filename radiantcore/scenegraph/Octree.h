@@ -63,6 +63,8 @@ public:
 	// Returns the root node of this SP tree
 	ISPNodePtr getRoot() const;
 
+	bool foreachMemberInVolume(const VolumeTest& volume, const MemberVisitor& visitor) override;
+
 	// Callback used by the OctreeNodes to let the tree update its caching structures
 	void notifyLink(const scene::INodePtr& sceneNode, OctreeNode* node);
 	void notifyUnlink(const scene::INodePtr& sceneNode, OctreeNode* node);
@@ -80,6 +82,9 @@ private:
 	 * large enough to encompass the scenenode's bounds.
 	 */
 	void ensureRootSize(const scene::INodePtr& sceneNode);
+
+	// Recursive method used to descend the tree, returns false if the visitor signaled stop
+	bool foreachMemberInVolume_r(const ISPNode& node, const VolumeTest& volume, const MemberVisitor& visitor);
 };
 
 } // namespace scene
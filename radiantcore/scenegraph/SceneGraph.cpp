@@ -2,24 +2,47 @@
 
 #include "ivolumetest.h"
 #include "itextstream.h"
+#include "icommandsystem.h"
+#include "iregistry.h"
 
 #include "scene/InstanceWalkers.h"
 #include "debugging/debugging.h"
 
 #include "math/AABB.h"
 #include "Octree.h"
+#include "LooseOctree.h"
 #include "SceneGraphFactory.h"
+#include "SpacePartitionBenchmark.h"
+#include "registry/registry.h"
 #include "util/ScopedBoolLock.h"
 #include "module/StaticModule.h"
 
 namespace scene
 {
 
-SceneGraph::SceneGraph() :
-	_spacePartition(new Octree),
-	_visitedSPNodes(0),
-	_skippedSPNodes(0),
-	_traversalOngoing(false)
+namespace
+{
+	const char* const RKEY_SPACE_PARTITION_TYPE = "user/ui/scenegraph/spacePartition";
+	const char* const RKEY_COALESCE_BOUNDS_UPDATES = "user/ui/scenegraph/coalesceBoundsUpdates";
+}
+
+SpacePartitionType getConfiguredSpacePartitionType()
+{
+	return registry::getValue<std::string>(RKEY_SPACE_PARTITION_TYPE) == "looseOctree" ?
+		SpacePartitionType::LooseOctree : SpacePartitionType::Octree;
+}
+
+bool getConfiguredCoalesceBoundsUpdates()
+{
+	return registry::getValue<bool>(RKEY_COALESCE_BOUNDS_UPDATES);
+}
+
+SceneGraph::SceneGraph(SpacePartitionType spacePartitionType) :
+	_spacePartitionType(spacePartitionType),
+	_spacePartition(createSpacePartition()),
+	_traversalOngoing(false),
+	_coalesceBoundsUpdates(false),
+	_flushingDirtyBounds(false)
 {}
 
 SceneGraph::~SceneGraph()
@@ -87,8 +110,12 @@ void SceneGraph::setRoot(const IMapRootNodePtr& newRoot)
 
 	_root = newRoot;
 
+	// Pending bounds changes refer to the old space partition
+	_dirtyBoundsNodes.clear();
+	_dirtyBoundsNodeSet.clear();
+
 	// Refresh the space partition class
-	_spacePartition = std::make_shared<Octree>();
+	_spacePartition = createSpacePartition();
 
 	if (_root)
 	{
@@ -188,16 +215,64 @@ void SceneGraph::erase(const INodePtr& node)
 
 void SceneGraph::nodeBoundsChanged(const INodePtr& node)
 {
+	if (_coalesceBoundsUpdates && !_flushingDirtyBounds)
+	{
+		// Just remember the node, the space partition is updated on the next query
+		_boundsUpdateStats.boundsChanges++;
+
+		if (_dirtyBoundsNodeSet.insert(node.get()).second)
+		{
+			_dirtyBoundsNodes.push_back(node);
+		}
+
+		return;
+	}
+
 	if (_traversalOngoing)
 	{
 		_actionBuffer.push_back(NodeAction(BoundsChange, node));
 		return;
 	}
 
+	_boundsUpdateStats.boundsChanges++;
+
+	relinkNode(node);
+}
+
+Graph::BoundsUpdateStatistics SceneGraph::getBoundsUpdateStatistics() const
+{
+	return _boundsUpdateStats;
+}
+
+void SceneGraph::relinkNode(const INodePtr& node)
+{
 	if (_spacePartition->unlink(node))
 	{
 		// unlink returned true, so the given node was linked before => re-link it
 		_spacePartition->link(node);
+		_boundsUpdateStats.relinks++;
+	}
+}
+
+void SceneGraph::flushDirtyBounds()
+{
+	if (_dirtyBoundsNodes.empty()) return;
+
+	// Re-linking would modify the partition members being iterated over,
+	// the nodes stay dirty until the traversal has finished
+	if (_traversalOngoing) return;
+
+	// Bounds notifications fired while re-linking are handled right away,
+	// these are coming from the nodes evaluating their bounds in link()
+	util::ScopedBoolLock flushing(_flushingDirtyBounds);
+
+	std::vector<INodePtr> dirtyNodes;
+	dirtyNodes.swap(_dirtyBoundsNodes);
+	_dirtyBoundsNodeSet.clear();
+
+	for (const INodePtr& node : dirtyNodes)
+	{
+		relinkNode(node);
 	}
 }
 
@@ -248,22 +323,31 @@ void SceneGraph::foreachNodeInVolume(const VolumeTest& volume, const INode::Visi
 	// changes during traversal so let's call this now. If nothing got changed, this call is very cheap.
 	if (_root != nullptr) _root->worldAABB();
 
+	// Apply all pending bounds changes in one go
+	flushDirtyBounds();
+
 	{
 		// Buffer any calls that might happen in between
 		util::ScopedBoolLock traversal(_traversalOngoing);
 
-		// Descend the SpacePartition tree and call the walker for each (partially) visible member
-		ISPNodePtr root = _spacePartition->getRoot();
-
-		_visitedSPNodes = _skippedSPNodes = 0;
-
-		foreachNodeInVolume_r(*root, volume, functor, visitHidden);
+		// Let the SpacePartition call us for each (partially) visible member
+		_spacePartition->foreachMemberInVolume(volume, [&](const INodePtr& node)
+		{
+			// Skip hidden nodes, if specified
+			if (!visitHidden && !node->visible())
+			{
+				return true;
+			}
 
-		_visitedSPNodes = _skippedSPNodes = 0;
+			return functor(node);
+		});
 	}
 
 	// Traversal finished, flush the action buffer
 	flushActionBuffer();
+
+	// Apply the bounds changes which came in during the traversal
+	flushDirtyBounds();
 }
 
 void SceneGraph::foreachNodeInVolume(const VolumeTest& volume, Walker& walker)
@@ -282,57 +366,37 @@ void SceneGraph::foreachVisibleNodeInVolume(const VolumeTest& volume, Walker& wa
 		false); // don't visit hidden
 }
 
-bool SceneGraph::foreachNodeInVolume_r(const ISPNode& node, const VolumeTest& volume,
-									   const INode::VisitorFunc& functor, bool visitHidden)
+ISpacePartitionSystemPtr SceneGraph::getSpacePartition()
 {
-	_visitedSPNodes++;
+	// Clients expect an up to date partition
+	flushDirtyBounds();
 
-	// Visit all members
-	const ISPNode::MemberList& members = node.getMembers();
-
-	for (ISPNode::MemberList::const_iterator m = members.begin();
-		 m != members.end(); /* in-loop increment */)
-	{
-		// Skip hidden nodes, if specified
-		if (!visitHidden && !(*m)->visible())
-		{
-			++m;
-			continue;
-		}
+	return _spacePartition;
+}
 
-		// We're done, as soon as the walker returns FALSE
-		if (!functor(*m++))
-		{
-			return false;
-		}
-	}
+void SceneGraph::setSpacePartitionType(SpacePartitionType type)
+{
+	_spacePartitionType = type;
+}
 
-	// Now consider the children
-	const ISPNode::NodeList& children = node.getChildNodes();
+void SceneGraph::setCoalesceBoundsUpdates(bool coalesce)
+{
+	_coalesceBoundsUpdates = coalesce;
 
-	for (ISPNode::NodeList::const_iterator i = children.begin(); i != children.end(); ++i)
+	if (!_coalesceBoundsUpdates)
 	{
-		if (volume.TestAABB((*i)->getBounds()) == VOLUME_OUTSIDE)
-		{
-			// Skip this node, not visible
-			_skippedSPNodes++;
-			continue;
-		}
-
-		// Traverse all the children too, enter recursion
-		if (!foreachNodeInVolume_r(**i, volume, functor, visitHidden))
-		{
-			// The walker returned false somewhere in the recursion depths, propagate this message
-			return false;
-		}
+		flushDirtyBounds();
 	}
-
-	return true; // continue traversal
 }
 
-ISpacePartitionSystemPtr SceneGraph::getSpacePartition()
+ISpacePartitionSystemPtr SceneGraph::createSpacePartition() const
 {
-	return _spacePartition;
+	if (_spacePartitionType == SpacePartitionType::LooseOctree)
+	{
+		return std::make_shared<LooseOctree>();
+	}
+
+	return std::make_shared<Octree>();
 }
 
 void SceneGraph::flushActionBuffer()
@@ -366,12 +430,24 @@ const std::string& SceneGraphModule::getName() const
 
 const StringSet& SceneGraphModule::getDependencies() const
 {
-	static StringSet _dependencies; // no deps
+	static StringSet _dependencies;
+
+	if (_dependencies.empty())
+	{
+		_dependencies.insert(MODULE_XMLREGISTRY);
+		_dependencies.insert(MODULE_COMMANDSYSTEM);
+	}
+
 	return _dependencies;
 }
 
 void SceneGraphModule::initialiseModule(const IApplicationContext& ctx)
 {
+	setSpacePartitionType(getConfiguredSpacePartitionType());
+	setCoalesceBoundsUpdates(getConfiguredCoalesceBoundsUpdates());
+
+	GlobalCommandSystem().addCommand("BenchmarkSpacePartition", benchmarkSpacePartition,
+		{ cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL });
 }
 
 // Static module instances
@@ -2,6 +2,8 @@
 
 #include <map>
 #include <list>
+#include <vector>
+#include <unordered_set>
 #include <sigc++/signal.h>
 #include <sigc++/connection.h>
 
@@ -14,6 +16,19 @@
 namespace scene
 {
 
+// The available ISpacePartitionSystem implementations
+enum class SpacePartitionType
+{
+	Octree,
+	LooseOctree,
+};
+
+// Returns the space partition type as configured in the registry
+SpacePartitionType getConfiguredSpacePartitionType();
+
+// Returns true if deferred bounds updates are enabled in the registry
+bool getConfiguredCoalesceBoundsUpdates();
+
 /**
  * Implementing class for the scenegraph.
  *
@@ -34,11 +49,9 @@ private:
 	IMapRootNodePtr _root;
 
 	// The space partitioning system
+	SpacePartitionType _spacePartitionType;
 	ISpacePartitionSystemPtr _spacePartition;
 
-	std::size_t _visitedSPNodes;
-	std::size_t _skippedSPNodes;
-
 	// During partition traversal all link/unlink calls are buffered and
 	// performed later on.
 	enum ActionType
@@ -53,10 +66,19 @@ private:
 
 	bool _traversalOngoing;
 
+	// In coalescing mode, bounds changes are collected and the affected
+	// nodes are re-linked in one go before the space partition is queried
+	bool _coalesceBoundsUpdates;
+	bool _flushingDirtyBounds;
+	std::vector<INodePtr> _dirtyBoundsNodes;
+	std::unordered_set<INode*> _dirtyBoundsNodeSet;
+
+	BoundsUpdateStatistics _boundsUpdateStats;
+
 	sigc::connection _undoEventHandler;
 
 public:
-	SceneGraph();
+	SceneGraph(SpacePartitionType spacePartitionType = SpacePartitionType::Octree);
 
 	~SceneGraph();
 
@@ -85,6 +107,8 @@ public:
 
 	void nodeBoundsChanged(const scene::INodePtr& node) override;
 
+	BoundsUpdateStatistics getBoundsUpdateStatistics() const override;
+
 	// Walker variants
 	void foreachNodeInVolume(const VolumeTest& volume, Walker& walker) override;
 	void foreachVisibleNodeInVolume(const VolumeTest& volume, Walker& walker) override;
@@ -96,15 +120,26 @@ public:
 	void foreachVisibleNodeInVolume(const VolumeTest& volume, const INode::VisitorFunc& functor) override;
 
 	ISpacePartitionSystemPtr getSpacePartition() override;
+
+	// Changes the space partition implementation, takes effect on the next setRoot() call
+	void setSpacePartitionType(SpacePartitionType type);
+
+	// Enables or disables deferred space partition updates on bounds changes
+	void setCoalesceBoundsUpdates(bool coalesce);
+
 private:
 	void foreachNodeInVolume(const VolumeTest& volume, const INode::VisitorFunc& functor, bool visitHidden);
 
-	// Recursive method used to descend the SpacePartition tree, returns FALSE if the walker signaled stop
-	bool foreachNodeInVolume_r(const ISPNode& node, const VolumeTest& volume, 
-							   const INode::VisitorFunc& functor, bool visitHidden);
+	ISpacePartitionSystemPtr createSpacePartition() const;
 
 	void flushActionBuffer();
 
+	// Re-links all nodes whose bounds changed since the last call,
+	// does nothing while a volume traversal is ongoing
+	void flushDirtyBounds();
+
+	void relinkNode(const INodePtr& node);
+
 	void onUndoEvent(IUndoSystem::EventType type, const std::string& operationName);
 };
 typedef std::shared_ptr<SceneGraph> SceneGraphPtr;
@@ -1,6 +1,7 @@
 #include "SceneGraphFactory.h"
 
 #include "itextstream.h"
+#include "iregistry.h"
 #include "SceneGraph.h"
 
 namespace scene
@@ -8,7 +9,10 @@ namespace scene
 
 GraphPtr SceneGraphFactory::createSceneGraph()
 {
-	return std::make_shared<SceneGraph>();
+	auto graph = std::make_shared<SceneGraph>(getConfiguredSpacePartitionType());
+	graph->setCoalesceBoundsUpdates(getConfiguredCoalesceBoundsUpdates());
+
+	return graph;
 }
 
 const std::string& SceneGraphFactory::getName() const
@@ -19,7 +23,13 @@ const std::string& SceneGraphFactory::getName() const
 
 const StringSet& SceneGraphFactory::getDependencies() const
 {
-	static StringSet _dependencies; // no dependencies
+	static StringSet _dependencies;
+
+	if (_dependencies.empty())
+	{
+		_dependencies.insert(MODULE_XMLREGISTRY);
+	}
+
 	return _dependencies;
 }
 
@@ -0,0 +1,211 @@
+#include "SpacePartitionBenchmark.h"
+
+#include <random>
+#include <fmt/format.h>
+
+#include "iscenegraph.h"
+#include "itextstream.h"
+#include "scene/Node.h"
+#include "render/AABBVolumeTest.h"
+#include "time/StopWatch.h"
+
+#include "Octree.h"
+#include "LooseOctree.h"
+
+namespace scene
+{
+
+namespace
+{
+	const int DEFAULT_SYNTHETIC_NODE_COUNT = 40000;
+	const std::size_t NUM_VOLUME_QUERIES = 1000;
+	const double QUERY_EXTENTS = 1024;
+	const double WORLD_EXTENTS = 16384;
+
+	// Stand-in node with fixed bounds. The benchmark never links
+	// the actual map nodes since they're already linked to the live scene.
+	class BoundsNode final :
+		public Node
+	{
+	private:
+		AABB _localAABB;
+
+	public:
+		BoundsNode(const AABB& bounds) :
+			_localAABB(bounds)
+		{}
+
+		Type getNodeType() const override
+		{
+			return Type::Unknown;
+		}
+
+		const AABB& localAABB() const override
+		{
+			return _localAABB;
+		}
+
+		void onPreRender(const VolumeTest& volume) override
+		{}
+
+		void renderHighlights(IRenderableCollector& collector, const VolumeTest& volume) override
+		{}
+
+		std::size_t getHighlightFlags() override
+		{
+			return Highlight::NoHighlight;
+		}
+	};
+
+	std::vector<INodePtr> createSyntheticNodes(std::size_t count)
+	{
+		// Fixed seed, such that the results are comparable across runs
+		std::mt19937 generator(1);
+		std::uniform_real_distribution<double> position(-WORLD_EXTENTS, WORLD_EXTENTS);
+		std::uniform_real_distribution<double> unit(0, 1);
+
+		std::vector<INodePtr> nodes;
+		nodes.reserve(count);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			// Mimic a typical map: mostly small brushes, some rooms, a few large hulls
+			double chance = unit(generator);
+			double maxSize = chance < 0.9 ? 64 : (chance < 0.99 ? 512 : 4096);
+
+			Vector3 extents(8 + unit(generator) * maxSize, 8 + unit(generator) * maxSize, 8 + unit(generator) * maxSize);
+			Vector3 origin(position(generator), position(generator), position(generator) * 0.25);
+
+			nodes.emplace_back(std::make_shared<BoundsNode>(AABB(origin, extents)));
+		}
+
+		return nodes;
+	}
+
+	std::vector<INodePtr> createNodesFromMap()
+	{
+		std::vector<INodePtr> nodes;
+
+		GlobalSceneGraph().foreachNode([&](const INodePtr& node)
+		{
+			if (!node->isRoot())
+			{
+				nodes.emplace_back(std::make_shared<BoundsNode>(node->worldAABB()));
+			}
+
+			return true;
+		});
+
+		return nodes;
+	}
+
+	std::vector<render::AABBVolumeTest> createQueryVolumes()
+	{
+		std::mt19937 generator(2);
+		std::uniform_real_distribution<double> position(-WORLD_EXTENTS, WORLD_EXTENTS);
+
+		std::vector<render::AABBVolumeTest> volumes;
+		volumes.reserve(NUM_VOLUME_QUERIES);
+
+		for (std::size_t i = 0; i < NUM_VOLUME_QUERIES; ++i)
+		{
+			Vector3 origin(position(generator), position(generator), position(generator) * 0.25);
+			volumes.emplace_back(AABB(origin, Vector3(QUERY_EXTENTS, QUERY_EXTENTS, QUERY_EXTENTS)));
+		}
+
+		return volumes;
+	}
+
+	std::string formatRate(std::size_t operations, std::size_t usecs)
+	{
+		return fmt::format("{0:8.2f} ms ({1:8.0f} ops/ms)", usecs / 1000.0,
+			usecs > 0 ? operations * 1000.0 / usecs : 0.0);
+	}
+
+	void runBenchmark(const std::string& name, ISpacePartitionSystem& partition,
+		const std::vector<INodePtr>& nodes, const std::vector<render::AABBVolumeTest>& volumes)
+	{
+		util::StopWatch timer;
+
+		for (const auto& node : nodes)
+		{
+			partition.link(node);
+		}
+
+		auto linkTime = timer.getMicroSecondsPassed();
+		timer.restart();
+
+		// Emulate moving everything around once
+		for (const auto& node : nodes)
+		{
+			partition.unlink(node);
+			partition.link(node);
+		}
+
+		auto relinkTime = timer.getMicroSecondsPassed();
+		timer.restart();
+
+		std::size_t visitedMembers = 0;
+
+		for (const auto& volume : volumes)
+		{
+			partition.foreachMemberInVolume(volume, [&](const INodePtr& node)
+			{
+				++visitedMembers;
+				return true;
+			});
+		}
+
+		auto queryTime = timer.getMicroSecondsPassed();
+		timer.restart();
+
+		for (const auto& node : nodes)
+		{
+			partition.unlink(node);
+		}
+
+		auto unlinkTime = timer.getMicroSecondsPassed();
+
+		rMessage() << "  " << name << ":" << std::endl
+			<< "    link:   " << formatRate(nodes.size(), linkTime) << std::endl
+			<< "    relink: " << formatRate(nodes.size(), relinkTime) << std::endl
+			<< "    query:  " << formatRate(volumes.size(), queryTime)
+			<< ", " << visitedMembers << " members visited" << std::endl
+			<< "    unlink: " << formatRate(nodes.size(), unlinkTime) << std::endl;
+	}
+
+	void runBenchmarks(const std::string& title, const std::vector<INodePtr>& nodes)
+	{
+		auto volumes = createQueryVolumes();
+
+		rMessage() << "Space partition benchmark, " << title << " (" << nodes.size() << " nodes, "
+			<< volumes.size() << " volume queries)" << std::endl;
+
+		{
+			Octree octree;
+			runBenchmark("Octree", octree, nodes, volumes);
+		}
+
+		{
+			LooseOctree looseOctree;
+			runBenchmark("LooseOctree", looseOctree, nodes, volumes);
+		}
+	}
+}
+
+void benchmarkSpacePartition(const cmd::ArgumentList& args)
+{
+	int syntheticNodeCount = !args.empty() ? args[0].getInt() : DEFAULT_SYNTHETIC_NODE_COUNT;
+
+	if (syntheticNodeCount > 0)
+	{
+		runBenchmarks("synthetic", createSyntheticNodes(static_cast<std::size_t>(syntheticNodeCount)));
+	}
+
+	if (GlobalSceneGraph().root())
+	{
+		runBenchmarks("current map", createNodesFromMap());
+	}
+}
+
+}
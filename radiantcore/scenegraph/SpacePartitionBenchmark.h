@@ -0,0 +1,17 @@
+#pragma once
+
+#include "icommandsystem.h"
+
+namespace scene
+{
+
+/**
+ * Command target comparing the link/unlink/volume query throughput of
+ * the available space partition implementations. It runs once on a
+ * synthetic set of bounds (the number of which can be passed as argument)
+ * and once on the bounds of the nodes in the currently loaded map.
+ * The results are written to the console.
+ */
+void benchmarkSpacePartition(const cmd::ArgumentList& args);
+
+}
@@ -16,6 +16,8 @@
 #include "selectionlib.h"
 #include "entitylib.h"
 #include "scene/SelectionIndex.h"
+#include "render/AABBVolumeTest.h"
+#include "time/StopWatch.h"
 
 #include "SelectionPolicies.h"
 #include "selection/SceneWalkers.h"
@@ -33,6 +35,7 @@
 #include "messages/GridSnapRequest.h"
 
 #include <stack>
+#include <unordered_set>
 
 namespace selection
 {
@@ -490,11 +493,11 @@ void deleteSelectionCmd(const cmd::ArgumentList& args)
 /**
  * Selects all objects that intersect one of the bounding AABBs.
  * The exact intersection-method is specified through TSelectionPolicy,
- * which must implement an evalute() method taking an AABB and the scene::INodePtr.
+ * which must implement an evalute() method taking an AABB and the scene::INodePtr,
+ * and getQueryBounds() to find the candidate nodes in the space partition.
  */
 template<class TSelectionPolicy>
-class SelectByBounds :
-	public scene::NodeVisitor
+class SelectByBounds
 {
 	const std::vector<AABB>& _aabbs;	// selection aabbs
 	TSelectionPolicy policy;	// type that contains a custom intersection method aabb<->aabb
@@ -504,41 +507,83 @@ public:
 		_aabbs(aabbs)
 	{}
 
-	bool pre(const scene::INodePtr& node) override
+	// Returns the nodes to select, in the order they have been found
+	std::vector<scene::INodePtr> findNodes(std::size_t& numCandidates) const
 	{
-		// Don't traverse hidden nodes
-		if (!node->visible()) return false;
+		std::vector<scene::INodePtr> result;
 
-		ISelectablePtr selectable = scene::node_cast<ISelectable>(node);
+		// The boxes are usually overlapping, visit each node only once
+		std::unordered_set<scene::INode*> visited;
+
+		for (const auto& aabb : _aabbs)
+		{
+			render::AABBVolumeTest volume(policy.getQueryBounds(aabb));
+
+			GlobalSceneGraph().foreachVisibleNodeInVolume(volume, [&](const scene::INodePtr& node)
+			{
+				if (visited.insert(node.get()).second && shouldBeSelected(node))
+				{
+					result.push_back(node);
+				}
+
+				return true;
+			});
+		}
 
+		numCandidates = visited.size();
+
+		return result;
+	}
+
+private:
+	bool isSelectable(const scene::INodePtr& node) const
+	{
 		// ignore worldspawn
 		Entity* entity = Node_getEntity(node);
 
 		if (entity != NULL && entity->isWorldspawn())
 		{
-			return true;
+			return false;
 		}
 
-		bool selected = false;
+		return scene::node_cast<ISelectable>(node) && node->getParent() && !node->isRoot();
+	}
 
-		if (selectable && node->getParent() && !node->isRoot())
+	bool passesTest(const scene::INodePtr& node) const
+	{
+		for (const auto& aabb : _aabbs)
 		{
-			for (const auto& aabb : _aabbs)
+			// Check if the selectable passes the AABB test
+			if (policy.evaluate(aabb, node))
 			{
-				// Check if the selectable passes the AABB test
-				if (policy.evaluate(aabb, node))
-				{
-					selectable->setSelected(true);
-					selected = true;
-					break;
-				}
+				return true;
 			}
 		}
 
-		// Only traverse the children of this node, if the node itself couldn't be selected
-		return !selected;
+		return false;
 	}
 
+	bool shouldBeSelected(const scene::INodePtr& node) const
+	{
+		if (!isSelectable(node) || !passesTest(node))
+		{
+			return false;
+		}
+
+		// The children of hidden nodes and of nodes being selected
+		// themselves are not considered
+		for (auto parent = node->getParent(); parent && !parent->isRoot(); parent = parent->getParent())
+		{
+			if (!parent->visible() || (isSelectable(parent) && passesTest(parent)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+public:
 	/**
 	 * Performs selection operation on the global scenegraph.
 	 * If delete_bounds_src is true, then the objects which were
@@ -581,8 +626,18 @@ public:
 
 	static void DoSelection(const std::vector<AABB>& aabbs)
 	{
-		SelectByBounds<TSelectionPolicy> walker(aabbs);
-		GlobalSceneGraph().root()->traverse(walker);
+		util::StopWatch timer;
+
+		std::size_t numCandidates = 0;
+		auto nodes = SelectByBounds<TSelectionPolicy>(aabbs).findNodes(numCandidates);
+
+		for (const auto& node : nodes)
+		{
+			Node_setSelected(node, true);
+		}
+
+		rMessage() << "Selected " << nodes.size() << " of " << numCandidates << " nodes near " <<
+			aabbs.size() << " bounding box(es) in " << timer.getMilliSecondsPassed() << " ms" << std::endl;
 
 		SceneChangeNotify();
 	}
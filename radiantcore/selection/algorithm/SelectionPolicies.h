@@ -1,9 +1,16 @@
 #pragma once
 
+#include <limits>
 #include "math/AABB.h"
 #include "ilightnode.h"
 #include "iorthoview.h"
 
+/**
+ * Besides evaluate(), each SelectionPolicy provides getQueryBounds(), returning
+ * the region any node passing the test for the given box needs to intersect.
+ * It is used to find the candidate nodes in the scene's space partition.
+ */
+
 /**
   SelectionPolicy for SelectByBounds
   Returns true if
@@ -25,14 +32,38 @@ public:
 			other = light->getSelectAABB();
 		}
 
-		// Determine the viewtype
-		OrthoOrientation viewType = GlobalOrthoViewManager().getActiveViewType();
+		unsigned int axis1 = 0;
+		unsigned int axis2 = 1;
+		getViewAxes(axis1, axis2);
+
+		// Check if the AABB is contained
+		auto dist1 = fabs(other.origin[axis1] - box.origin[axis1]) + fabs(other.extents[axis1]);
+		auto dist2 = fabs(other.origin[axis2] - box.origin[axis2]) + fabs(other.extents[axis2]);
+
+		return (dist1 < fabs(box.extents[axis1]) && dist2 < fabs(box.extents[axis2]));
+	}
 
+	// The box is extended infinitely along the axis the active view is looking at
+	AABB getQueryBounds(const AABB& box) const
+	{
 		unsigned int axis1 = 0;
 		unsigned int axis2 = 1;
+		getViewAxes(axis1, axis2);
+
+		AABB bounds(box.origin, Vector3(std::numeric_limits<double>::max(),
+			std::numeric_limits<double>::max(), std::numeric_limits<double>::max()));
+
+		bounds.extents[axis1] = fabs(box.extents[axis1]);
+		bounds.extents[axis2] = fabs(box.extents[axis2]);
+
+		return bounds;
+	}
 
-		// Determine which axes have to be compared
-		switch (viewType) {
+private:
+	// Determines which axes have to be compared, depending on the active view type
+	static void getViewAxes(unsigned int& axis1, unsigned int& axis2)
+	{
+		switch (GlobalOrthoViewManager().getActiveViewType()) {
 			case OrthoOrientation::XY:
 				axis1 = 0;
 				axis2 = 1;
@@ -46,12 +77,6 @@ public:
 				axis2 = 2;
 			break;
 		};
-
-		// Check if the AABB is contained
-		auto dist1 = fabs(other.origin[axis1] - box.origin[axis1]) + fabs(other.extents[axis1]);
-		auto dist2 = fabs(other.origin[axis2] - box.origin[axis2]) + fabs(other.extents[axis2]);
-
-		return (dist1 < fabs(box.extents[axis1]) && dist2 < fabs(box.extents[axis2]));
 	}
 };
 
@@ -73,6 +98,11 @@ public:
 
 		return true;
 	}
+
+	AABB getQueryBounds(const AABB& box) const
+	{
+		return box;
+	}
 };
 
 /**
@@ -103,6 +133,12 @@ public:
 
 		return true;
 	}
+
+	// Light diamonds inside the box have their origin in it, which is part of the light bounds
+	AABB getQueryBounds(const AABB& box) const
+	{
+		return box;
+	}
 };
 
 /**
@@ -136,4 +172,9 @@ public:
 
 		return true;
 	}
+
+	AABB getQueryBounds(const AABB& box) const
+	{
+		return box;
+	}
 };
@@ -78,7 +78,7 @@ std::string Game::getXPathRoot() const
 
 std::string Game::getKeyValue(const std::string& key) const
 {
-	if (xml::NodeList found = GlobalRegistry().findXPath(getXPathRoot()); !found.empty()) {
+	if (xml::NodeList found = GlobalRegistry().findXPathReadOnly(getXPathRoot()); !found.empty()) {
 		return found[0].getAttributeValue(key);
 	}
 	else {
@@ -108,7 +108,7 @@ bool Game::hasFeature(const std::string& feature) const
 xml::NodeList Game::getLocalXPath(const std::string& localPath) const
 {
 	std::string absolutePath = getXPathRoot() + localPath;
-	return GlobalRegistry().findXPath(absolutePath);
+	return GlobalRegistry().findXPathReadOnly(absolutePath);
 }
 
 } // namespace game
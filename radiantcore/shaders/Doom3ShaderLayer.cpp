@@ -186,7 +186,7 @@ TexturePtr Doom3ShaderLayer::getTexture() const
 			_type == BUMP ? BindableTexture::Role::NORMAL_MAP
 						  : BindableTexture::Role::COLOUR
 		);
-		_texture = GetTextureManager().getBinding(_bindableTex, role);
+		_texture = GetTextureManager().getBindingDeferred(_bindableTex, role);
 	}
 
 	return _texture;
@@ -30,6 +30,9 @@ namespace
     const std::string IMAGE_FLAT = "_flat.png";
     const std::string IMAGE_BLACK = "_black.png";
 
+    // Time per frame spent on uploading textures loaded in the background
+    const std::size_t TEXTURE_UPLOAD_BUDGET_MSECS = 8;
+
     inline std::string getBitmapsPath()
     {
         return module::GlobalModuleRegistry().getApplicationContext().getBitmapsPath();
@@ -274,6 +277,16 @@ void MaterialManager::reloadImages()
     });
 }
 
+void MaterialManager::uploadPendingTextures()
+{
+    _textureManager->uploadPendingTextures(TEXTURE_UPLOAD_BUDGET_MSECS);
+}
+
+bool MaterialManager::hasPendingTextureUploads()
+{
+    return _textureManager->hasPendingUploads();
+}
+
 const std::string& MaterialManager::getName() const
 {
     static std::string _name(MODULE_SHADERSYSTEM);
@@ -310,6 +323,10 @@ void MaterialManager::initialiseModule(const IApplicationContext& ctx)
     GlobalFiletypes().registerPattern("material", FileTypePattern(_("Material File"), "mtr", "*.mtr"));
 
     GlobalCommandSystem().addCommand("ReloadImages", [this](const cmd::ArgumentList&) { reloadImages(); });
+    GlobalCommandSystem().addCommand("PrintTextureLoadStatistics", [this](const cmd::ArgumentList&)
+    {
+        _textureManager->printLoadStatistics();
+    });
 }
 
 void MaterialManager::onMaterialDefsReloaded()
@@ -326,6 +343,9 @@ void MaterialManager::shutdownModule()
 {
     rMessage() << "MaterialManager::shutdownModule called" << std::endl;
 
+    // The workers are using the image loader, stop them while it is still there
+    _textureManager->stopWorkers();
+
     destroy();
     _library->clear();
     _library.reset();
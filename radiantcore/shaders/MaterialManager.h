@@ -89,6 +89,8 @@ public:
 	ITableDefinition::Ptr getTable(const std::string& name) override;
 
 	void reloadImages() override;
+	void uploadPendingTextures() override;
+	bool hasPendingTextureUploads() override;
 
 public:
 	sigc::signal<void> signal_activeShadersChanged() const override;
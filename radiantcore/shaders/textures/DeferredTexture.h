@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Texture.h>
+
+namespace shaders
+{
+
+/**
+ * \brief
+ * Texture whose image is still being loaded in the background.
+ *
+ * It stands in for the placeholder texture until the GLTextureManager has
+ * uploaded the real one, after which all calls are forwarded to that. Since
+ * the returned object remains the same, anyone holding on to the TexturePtr
+ * will pick up the loaded texture without having to ask again.
+ */
+class DeferredTexture
+: public Texture
+{
+    // Display name
+    std::string _name;
+
+    // Used as long as the texture is not loaded
+    TexturePtr _placeholder;
+
+    // The uploaded texture, empty while loading
+    TexturePtr _texture;
+
+public:
+    DeferredTexture(const std::string& name, const TexturePtr& placeholder)
+    : _name(name), _placeholder(placeholder)
+    { }
+
+    bool isLoaded() const
+    {
+        return _texture != nullptr;
+    }
+
+    void setTexture(const TexturePtr& texture)
+    {
+        _texture = texture;
+    }
+
+    /* Texture implementation */
+
+    std::string getName() const override
+    {
+        return _name;
+    }
+
+    GLuint getGLTexNum() const override
+    {
+        auto texture = getCurrentTexture();
+        return texture ? texture->getGLTexNum() : 0;
+    }
+
+    std::size_t getWidth() const override
+    {
+        auto texture = getCurrentTexture();
+        return texture ? texture->getWidth() : INVALID_SIZE;
+    }
+
+    std::size_t getHeight() const override
+    {
+        auto texture = getCurrentTexture();
+        return texture ? texture->getHeight() : INVALID_SIZE;
+    }
+
+private:
+    const Texture* getCurrentTexture() const
+    {
+        return _texture ? _texture.get() : _placeholder.get();
+    }
+};
+
+}
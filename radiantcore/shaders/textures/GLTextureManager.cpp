@@ -8,14 +8,33 @@
 #include "../MapExpression.h"
 #include "TextureManipulator.h"
 #include "parser/DefTokeniser.h"
+#include "time/StopWatch.h"
+#include <fmt/format.h>
 
 namespace
 {
     const std::string SHADER_NOT_FOUND = "_missing_texture.png";
+    const std::string PLACEHOLDER_COLOUR = "_black.png";
+    const std::string PLACEHOLDER_NORMAL_MAP = "_flat.png";
+
+    // Image decoding is mostly bound by file access, no need for many threads
+    const unsigned int MAX_WORKER_THREADS = 4;
 }
 
 namespace shaders {
 
+GLTextureManager::GLTextureManager() :
+    _shutdown(false),
+    _numQueued(0),
+    _numDecoded(0),
+    _numUploaded(0)
+{}
+
+GLTextureManager::~GLTextureManager()
+{
+    stopWorkers();
+}
+
 void GLTextureManager::checkBindings()
 {
     // Check the TextureMap for unique pointers and release them
@@ -53,22 +72,193 @@ TexturePtr GLTextureManager::getBinding(const NamedBindablePtr& bindable,
     auto existing = _textures.find(identifier);
     if (existing != _textures.end())
     {
+        // A texture still loading in the background is needed right now,
+        // load it on this thread, the finished upload will be skipped
+        auto deferred = std::dynamic_pointer_cast<DeferredTexture>(existing->second);
+
+        if (deferred && !deferred->isLoaded())
+        {
+            auto texture = loadTexture(bindable, identifier, role);
+            deferred->setTexture(texture ? texture : getShaderNotFound());
+        }
+
         // Found, return
         return existing->second;
     }
 
     // Create and insert texture object, if it is valid
-    auto texture = bindable->bindTexture(identifier, role);
+    auto texture = loadTexture(bindable, identifier, role);
     if (texture)
     {
         _textures.emplace(identifier, texture);
         return texture;
     }
 
-    rError() << "[shaders] Unable to load texture: " << identifier << std::endl;
     return getShaderNotFound();
 }
 
+TexturePtr GLTextureManager::getBindingDeferred(const NamedBindablePtr& bindable,
+                                                BindableTexture::Role role)
+{
+    auto expression = std::dynamic_pointer_cast<MapExpression>(bindable);
+
+    // Only the images of map expressions can be loaded without GL context
+    if (!expression || _shutdown)
+    {
+        return getBinding(bindable, role);
+    }
+
+    auto identifier = bindable->getIdentifier();
+    auto existing = _textures.find(identifier);
+    if (existing != _textures.end())
+    {
+        return existing->second;
+    }
+
+    auto pending = std::make_shared<PendingTexture>();
+    pending->identifier = identifier;
+    pending->expression = expression;
+    pending->role = role;
+    pending->texture = std::make_shared<DeferredTexture>(identifier, getPlaceholder(role));
+
+    _textures.emplace(identifier, pending->texture);
+
+    startWorkers();
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _decodeQueue.push_back(pending);
+    }
+
+    ++_numQueued;
+    _decodeQueueSignal.notify_one();
+
+    return pending->texture;
+}
+
+TexturePtr GLTextureManager::loadTexture(const NamedBindablePtr& bindable,
+                                         const std::string& identifier,
+                                         BindableTexture::Role role)
+{
+    auto texture = bindable->bindTexture(identifier, role);
+
+    if (!texture)
+    {
+        rError() << "[shaders] Unable to load texture: " << identifier << std::endl;
+    }
+
+    return texture;
+}
+
+void GLTextureManager::uploadPendingTextures(std::size_t maxMilliSeconds)
+{
+    util::StopWatch timer;
+
+    while (timer.getMilliSecondsPassed() < maxMilliSeconds)
+    {
+        PendingTexturePtr pending;
+
+        {
+            std::lock_guard<std::mutex> lock(_queueLock);
+
+            if (_uploadQueue.empty()) return;
+
+            pending = _uploadQueue.front();
+            _uploadQueue.pop_front();
+        }
+
+        // Skip textures which have been requested synchronously in the meantime
+        if (pending->texture->isLoaded()) continue;
+
+        auto texture = pending->image ? pending->image->bindTexture(pending->identifier, pending->role) : TexturePtr();
+
+        if (!texture)
+        {
+            rError() << "[shaders] Unable to load texture: " << pending->identifier << std::endl;
+            texture = getShaderNotFound();
+        }
+
+        pending->texture->setTexture(texture);
+        ++_numUploaded;
+    }
+}
+
+bool GLTextureManager::hasPendingUploads()
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    return !_uploadQueue.empty();
+}
+
+void GLTextureManager::startWorkers()
+{
+    if (!_workers.empty()) return;
+
+    auto numThreads = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, MAX_WORKER_THREADS);
+
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        _workers.emplace_back(&GLTextureManager::processDecodeQueue, this);
+    }
+}
+
+void GLTextureManager::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _shutdown = true;
+        _decodeQueue.clear();
+    }
+
+    _decodeQueueSignal.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+
+    _workers.clear();
+}
+
+void GLTextureManager::processDecodeQueue()
+{
+    while (true)
+    {
+        PendingTexturePtr pending;
+
+        {
+            std::unique_lock<std::mutex> lock(_queueLock);
+
+            _decodeQueueSignal.wait(lock, [this]() { return _shutdown || !_decodeQueue.empty(); });
+
+            if (_shutdown) return;
+
+            pending = _decodeQueue.front();
+            _decodeQueue.pop_front();
+        }
+
+        // Load the image file(s) and evaluate the expression, without touching GL
+        try
+        {
+            pending->image = pending->expression->getImage();
+        }
+        catch (const std::exception& ex)
+        {
+            rError() << "[shaders] Failed to load image " << pending->identifier << ": " << ex.what() << std::endl;
+        }
+
+        ++_numDecoded;
+
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _uploadQueue.push_back(pending);
+    }
+}
+
+void GLTextureManager::printLoadStatistics() const
+{
+    rMessage() << fmt::format("[shaders] Background texture loading: {0} queued, {1} decoded, {2} uploaded",
+        _numQueued.load(), _numDecoded.load(), _numUploaded.load()) << std::endl;
+}
+
 TexturePtr GLTextureManager::getBinding(const std::string& fullPath)
 {
     // check if the texture has to be loaded
@@ -105,6 +295,19 @@ void GLTextureManager::clearCacheForBindable(const NamedBindablePtr& bindable)
     _textures.erase(bindable->getIdentifier());
 }
 
+TexturePtr GLTextureManager::getPlaceholder(BindableTexture::Role role)
+{
+    auto& placeholder = role == BindableTexture::Role::NORMAL_MAP ? _placeholderNormalMap : _placeholderColour;
+
+    if (!placeholder)
+    {
+        placeholder = loadStandardTexture(role == BindableTexture::Role::NORMAL_MAP ?
+            PLACEHOLDER_NORMAL_MAP : PLACEHOLDER_COLOUR);
+    }
+
+    return placeholder;
+}
+
 // Return the shader-not-found texture, loading if necessary
 TexturePtr GLTextureManager::getShaderNotFound()
 {
@@ -3,8 +3,15 @@
 
 #include "ishaders.h"
 #include <map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <condition_variable>
 #include "../MapExpression.h"
 #include "texturelib.h"
+#include "DeferredTexture.h"
 
 namespace shaders
 {
@@ -18,17 +25,87 @@ class GLTextureManager
 	// The fallback textures in case a texture is empty or broken
 	TexturePtr _shaderNotFound;
 
+	// Textures shown while the actual image is loaded in the background
+	TexturePtr _placeholderColour;
+	TexturePtr _placeholderNormalMap;
+
+	// A texture handed out by getBindingDeferred(), waiting for its image
+	struct PendingTexture
+	{
+		std::string identifier;
+		MapExpressionPtr expression;
+		BindableTexture::Role role;
+		std::shared_ptr<DeferredTexture> texture;
+
+		// Set by the worker thread
+		ImagePtr image;
+	};
+	using PendingTexturePtr = std::shared_ptr<PendingTexture>;
+
+	// Jobs waiting for a worker, and images waiting for their upload,
+	// both guarded by the mutex
+	std::deque<PendingTexturePtr> _decodeQueue;
+	std::deque<PendingTexturePtr> _uploadQueue;
+	std::mutex _queueLock;
+	std::condition_variable _decodeQueueSignal;
+
+	// The worker threads, started on first use
+	std::vector<std::thread> _workers;
+	bool _shutdown;
+
+	std::atomic<std::size_t> _numQueued;
+	std::atomic<std::size_t> _numDecoded;
+	std::atomic<std::size_t> _numUploaded;
+
 private:
 
 	// Constructs the fallback textures like "Shader Image Missing"
 	TexturePtr loadStandardTexture(const std::string& filename);
 
+	TexturePtr getPlaceholder(BindableTexture::Role role);
+
+	void startWorkers();
+	void processDecodeQueue();
+
+	// Creates the texture from the given bindable on the calling thread
+	TexturePtr loadTexture(const NamedBindablePtr& bindable, const std::string& identifier,
+						   BindableTexture::Role role);
+
 public:
+	GLTextureManager();
+	~GLTextureManager();
+
 
 	/// Construct a bound texture from a generic named bindable.
 	TexturePtr getBinding(const NamedBindablePtr& bindable,
 						  BindableTexture::Role role = BindableTexture::Role::COLOUR);
 
+	/**
+	 * Like getBinding(), but the image of map expressions is loaded on a
+	 * worker thread. A placeholder texture is returned right away, which
+	 * will refer to the actual texture as soon as uploadPendingTextures()
+	 * got around to upload it.
+	 */
+	TexturePtr getBindingDeferred(const NamedBindablePtr& bindable,
+								  BindableTexture::Role role = BindableTexture::Role::COLOUR);
+
+	/**
+	 * Uploads the images decoded by the worker threads to OpenGL.
+	 * Uploading stops when the given time budget is used up, the remaining
+	 * ones are left for the next call. Needs a valid GL context.
+	 */
+	void uploadPendingTextures(std::size_t maxMilliSeconds);
+
+	// True if decoded images are waiting for uploadPendingTextures()
+	bool hasPendingUploads();
+
+	// Discards the queued jobs and joins the worker threads, subsequent
+	// deferred requests are handled synchronously
+	void stopWorkers();
+
+	// Writes the number of queued, decoded and uploaded textures to the console
+	void printLoadStatistics() const;
+
 	/** greebo: This loads a texture directly from the disk using the
 	 * 			specified <fullPath>.
 	 *
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include "iarchive.h"
+#include "string/case_conv.h"
+
+namespace vfs
+{
+
+/**
+ * Merged lookup table of the files contained in a set of archives, mapping
+ * each lower-case VFS path to the archives providing it.
+ *
+ * Archives are identified by their position in the VFS search order,
+ * they need to be added with ascending positions such that the first
+ * archive registered for a path is the one taking precedence.
+ */
+class ArchivePathIndex
+{
+public:
+	static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+private:
+	struct Entry
+	{
+		// Position of the highest-priority archive containing the file
+		std::size_t firstArchive;
+
+		// Number of indexed archives containing this file
+		std::size_t archiveCount;
+	};
+
+	std::unordered_map<std::string, Entry> _entries;
+
+	class Collector :
+		public IArchive::Visitor
+	{
+	private:
+		ArchivePathIndex& _index;
+		std::size_t _position;
+
+	public:
+		Collector(ArchivePathIndex& index, std::size_t position) :
+			_index(index),
+			_position(position)
+		{}
+
+		void visitFile(const std::string& name, IArchiveFileInfoProvider& infoProvider) override
+		{
+			auto result = _index._entries.emplace(string::to_lower_copy(name), Entry{ _position, 1 });
+
+			if (!result.second)
+			{
+				result.first->second.archiveCount++;
+			}
+		}
+
+		bool visitDirectory(const std::string& name, std::size_t depth) override
+		{
+			return false; // don't skip anything
+		}
+	};
+
+public:
+	void clear()
+	{
+		_entries.clear();
+	}
+
+	bool empty() const
+	{
+		return _entries.empty();
+	}
+
+	std::size_t size() const
+	{
+		return _entries.size();
+	}
+
+	// Adds all the files of the given archive, located at the given search position
+	void addArchive(IArchive& archive, std::size_t position)
+	{
+		Collector collector(*this, position);
+		archive.traverse(collector, "");
+	}
+
+	// Returns the position of the highest-priority archive containing the given file,
+	// or NOT_FOUND if no indexed archive contains it
+	std::size_t findArchive(const std::string& path) const
+	{
+		auto found = _entries.find(string::to_lower_copy(path));
+		return found != _entries.end() ? found->second.firstArchive : NOT_FOUND;
+	}
+
+	// Returns the number of indexed archives containing the given file
+	std::size_t getArchiveCount(const std::string& path) const
+	{
+		auto found = _entries.find(string::to_lower_copy(path));
+		return found != _entries.end() ? found->second.archiveCount : 0;
+	}
+};
+
+}
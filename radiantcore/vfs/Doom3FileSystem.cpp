@@ -16,6 +16,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <locale>
+#include <chrono>
+#include <fmt/format.h>
 
 #include "iradiant.h"
 #include "idatastream.h"
@@ -41,11 +43,19 @@
 #include "SortedFilenames.h"
 #include "ZipArchive.h"
 #include "module/StaticModule.h"
+#include "registry/registry.h"
 #include "FileVisitor.h"
 
 namespace vfs
 {
 
+namespace
+{
+    // Mapped archives are faster to read from multiple threads, but an archive modified
+    // on disk while it is mapped crashes the process instead of producing a read error
+    const char* const RKEY_MEMORY_MAPPED_ARCHIVES = "user/ui/vfs/memoryMappedArchives";
+}
+
 void Doom3FileSystem::initDirectory(const std::string& inputPath)
 {
     // greebo: Normalise path: Replace backslashes and ensure trailing slash
@@ -54,14 +64,7 @@ void Doom3FileSystem::initDirectory(const std::string& inputPath)
     // Shortcut
     const std::string& path = _directories.back();
 
-    {
-        ArchiveDescriptor entry;
-        entry.name = path;
-        entry.archive = std::make_shared<DirectoryArchive>(path);
-        entry.is_pakfile = false;
-
-        _archives.push_back(entry);
-    }
+    addArchive(path, std::make_shared<DirectoryArchive>(path), false);
 
     // Instantiate a new sorting container for the filenames
     SortedFilenames filenameList;
@@ -139,6 +142,8 @@ void Doom3FileSystem::initialise(const SearchPaths& vfsSearchPaths, const std::s
         initDirectory(path);
     }
 
+    buildPathIndex();
+
     signal_Initialised().emit();
 }
 
@@ -149,6 +154,11 @@ bool Doom3FileSystem::isInitialised() const
 
 void Doom3FileSystem::shutdown()
 {
+    showLookupStatistics(cmd::ArgumentList());
+
+    _pathIndex.clear();
+    _pathIndexValid = false;
+    _directoryArchives.clear();
     _archives.clear();
     _directories.clear();
     _vfsSearchPaths.clear();
@@ -163,11 +173,133 @@ const std::set<std::string>& Doom3FileSystem::getArchiveExtensions() const
     return _allowedExtensions;
 }
 
+void Doom3FileSystem::addArchive(const std::string& name, const IArchive::Ptr& archive, bool isPakFile)
+{
+    ArchiveDescriptor entry;
+
+    entry.name = name;
+    entry.archive = archive;
+    entry.is_pakfile = isPakFile;
+
+    if (!isPakFile)
+    {
+        _directoryArchives.push_back(_archives.size());
+    }
+
+    _archives.push_back(entry);
+
+    // The index needs to be rebuilt to include this archive
+    _pathIndexValid = false;
+}
+
+void Doom3FileSystem::buildPathIndex()
+{
+    ScopedDebugTimer timer("[vfs] Built file index");
+
+    _pathIndex.clear();
+
+    for (std::size_t i = 0; i < _archives.size(); ++i)
+    {
+        if (_archives[i].is_pakfile)
+        {
+            _pathIndex.addArchive(*_archives[i].archive, i);
+        }
+    }
+
+    _pathIndexValid = true;
+
+    rMessage() << "[vfs] Indexed " << _pathIndex.size() << " paths in " <<
+        (_archives.size() - _directoryArchives.size()) << " pak files" << std::endl;
+}
+
+IArchive* Doom3FileSystem::findArchiveContainingFile(const std::string& filename)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    IArchive* result = nullptr;
+
+    if (_pathIndexValid)
+    {
+        auto pakPosition = _pathIndex.findArchive(filename);
+
+        // Loose directories in front of the winning pak still take precedence
+        for (auto position : _directoryArchives)
+        {
+            if (position > pakPosition) break;
+
+            if (_archives[position].archive->containsFile(filename))
+            {
+                result = _archives[position].archive.get();
+                break;
+            }
+        }
+
+        if (!result && pakPosition != ArchivePathIndex::NOT_FOUND)
+        {
+            result = _archives[pakPosition].archive.get();
+        }
+    }
+    else
+    {
+        // No index available, probe each archive in turn
+        for (const auto& descriptor : _archives)
+        {
+            if (descriptor.archive->containsFile(filename))
+            {
+                result = descriptor.archive.get();
+                break;
+            }
+        }
+    }
+
+    auto nanoseconds = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+
+    if (result)
+    {
+        _lookupStats.hits++;
+        _lookupStats.hitNanoseconds += nanoseconds;
+    }
+    else
+    {
+        _lookupStats.misses++;
+        _lookupStats.missNanoseconds += nanoseconds;
+    }
+
+    return result;
+}
+
+void Doom3FileSystem::showLookupStatistics(const cmd::ArgumentList& args)
+{
+    std::size_t hits = _lookupStats.hits;
+    std::size_t misses = _lookupStats.misses;
+
+    rMessage() << "[vfs] File lookups: " << (hits + misses) << std::endl;
+    rMessage() << fmt::format("[vfs]   hits:   {0} (avg. {1:.2f} us)", hits,
+        hits > 0 ? _lookupStats.hitNanoseconds / 1000.0 / hits : 0.0) << std::endl;
+    rMessage() << fmt::format("[vfs]   misses: {0} (avg. {1:.2f} us)", misses,
+        misses > 0 ? _lookupStats.missNanoseconds / 1000.0 / misses : 0.0) << std::endl;
+}
+
 int Doom3FileSystem::getFileCount(const std::string& filename)
 {
     int count = 0;
     std::string fixedFilename(os::standardPath(filename));
 
+    if (_pathIndexValid)
+    {
+        count = static_cast<int>(_pathIndex.getArchiveCount(fixedFilename));
+
+        for (auto position : _directoryArchives)
+        {
+            if (_archives[position].archive->containsFile(fixedFilename))
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
     for (const ArchiveDescriptor& descriptor : _archives)
     {
         if (descriptor.archive->containsFile(fixedFilename))
@@ -181,12 +313,10 @@ int Doom3FileSystem::getFileCount(const std::string& filename)
 
 FileInfo Doom3FileSystem::getFileInfo(const std::string& vfsRelativePath)
 {
-    for (const auto& descriptor : _archives)
+    auto archive = findArchiveContainingFile(vfsRelativePath);
+
+    if (archive)
     {
-        if (!descriptor.archive->containsFile(vfsRelativePath))
-        {
-            continue;
-        }
 
         // Determine the visibility of this file
         auto topLevelDir = os::getToplevelDirectory(vfsRelativePath);
@@ -201,7 +331,7 @@ FileInfo Doom3FileSystem::getFileInfo(const std::string& vfsRelativePath)
             visibility = assetsList->getVisibility(relativePath);
         }
 
-        return FileInfo("", vfsRelativePath, visibility, *descriptor.archive);
+        return FileInfo("", vfsRelativePath, visibility, *archive);
     }
 
     return FileInfo();
@@ -215,18 +345,10 @@ ArchiveFilePtr Doom3FileSystem::openFile(const std::string& filename)
         return ArchiveFilePtr();
     }
 
-    for (const auto& descriptor : _archives)
-    {
-        auto file = descriptor.archive->openFile(filename);
-
-        if (file)
-        {
-            return file;
-        }
-    }
+    auto archive = findArchiveContainingFile(filename);
 
     // not found
-    return ArchiveFilePtr();
+    return archive ? archive->openFile(filename) : ArchiveFilePtr();
 }
 
 ArchiveFilePtr Doom3FileSystem::openFileInAbsolutePath(const std::string& filename)
@@ -243,17 +365,9 @@ ArchiveFilePtr Doom3FileSystem::openFileInAbsolutePath(const std::string& filena
 
 ArchiveTextFilePtr Doom3FileSystem::openTextFile(const std::string& filename)
 {
-    for (const auto& descriptor : _archives)
-    {
-        auto file = descriptor.archive->openTextFile(filename);
+    auto archive = findArchiveContainingFile(filename);
 
-        if (file)
-        {
-            return file;
-        }
-    }
-
-    return ArchiveTextFilePtr();
+    return archive ? archive->openTextFile(filename) : ArchiveTextFilePtr();
 }
 
 ArchiveTextFilePtr Doom3FileSystem::openTextFileInAbsolutePath(const std::string& filename)
@@ -276,7 +390,7 @@ IArchive::Ptr Doom3FileSystem::openArchiveInAbsolutePath(const std::string& path
         return IArchive::Ptr();
     }
 
-    return std::make_shared<archive::ZipArchive>(pathToArchive);
+    return std::make_shared<archive::ZipArchive>(pathToArchive, _useMemoryMappedArchives);
 }
 
 std::shared_ptr<AssetsList> Doom3FileSystem::findAssetsList(const std::string& topLevelDir)
@@ -371,25 +485,15 @@ void Doom3FileSystem::initPakFile(const std::string& filename)
     if (_allowedExtensions.find(fileExt) != _allowedExtensions.end())
     {
         // Matched extension for archive (e.g. "pk3", "pk4")
-        ArchiveDescriptor entry;
-
-        entry.name = filename;
-        entry.archive = std::make_shared<archive::ZipArchive>(filename);
-        entry.is_pakfile = true;
-        _archives.push_back(entry);
+        addArchive(filename, std::make_shared<archive::ZipArchive>(filename, _useMemoryMappedArchives), true);
 
         rMessage() << "[vfs] pak file: " << filename << std::endl;
     }
     else if (_allowedExtensionsDir.find(fileExt) != _allowedExtensionsDir.end())
     {
         // Matched extension for archive dir (e.g. "pk3dir", "pk4dir")
-        ArchiveDescriptor entry;
-
         std::string path = os::standardPathWithSlash(filename);
-        entry.name = path;
-        entry.archive = std::make_shared<DirectoryArchive>(path);
-        entry.is_pakfile = false;
-        _archives.push_back(entry);
+        addArchive(path, std::make_shared<DirectoryArchive>(path), false);
 
         rMessage() << "[vfs] pak dir:  " << path << std::endl;
     }
@@ -421,11 +525,22 @@ const std::string& Doom3FileSystem::getName() const
 const StringSet& Doom3FileSystem::getDependencies() const
 {
     static StringSet _dependencies;
+
+    if (_dependencies.empty())
+    {
+        _dependencies.insert(MODULE_COMMANDSYSTEM);
+        _dependencies.insert(MODULE_XMLREGISTRY);
+    }
+
     return _dependencies;
 }
 
 void Doom3FileSystem::initialiseModule(const IApplicationContext& ctx)
 {
+    GlobalCommandSystem().addCommand("ShowVfsLookupStats",
+        std::bind(&Doom3FileSystem::showLookupStatistics, this, std::placeholders::_1));
+
+    _useMemoryMappedArchives = registry::getValue<bool>(RKEY_MEMORY_MAPPED_ARCHIVES);
 }
 
 void Doom3FileSystem::shutdownModule()
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include "iarchive.h"
 #include "ifilesystem.h"
+#include "icommandsystem.h"
+#include "ArchivePathIndex.h"
 
 namespace vfs
 {
@@ -27,7 +30,29 @@ private:
 		bool is_pakfile;
 	};
 
-	std::list<ArchiveDescriptor> _archives;
+	// All archives in search order
+	std::vector<ArchiveDescriptor> _archives;
+
+	// Index of all files contained in the pak files, loose directories
+	// are not indexed since their contents might change at any time
+	ArchivePathIndex _pathIndex;
+	bool _pathIndexValid = false;
+
+	// Positions of the non-pak archives in the _archives vector, ascending
+	std::vector<std::size_t> _directoryArchives;
+
+	// File lookup counters, lookups can happen on any thread
+	struct LookupStatistics
+	{
+		std::atomic<std::size_t> hits{ 0 };
+		std::atomic<std::size_t> misses{ 0 };
+		std::atomic<std::size_t> hitNanoseconds{ 0 };
+		std::atomic<std::size_t> missNanoseconds{ 0 };
+	};
+	LookupStatistics _lookupStats;
+
+	// Whether pak files are read through a memory mapping
+	bool _useMemoryMappedArchives = false;
 
 	sigc::signal<void> _sigInitialised;
 
@@ -79,6 +104,16 @@ private:
 	void initDirectory(const std::string& path);
 	void initPakFile(const std::string& filename);
 
+	void addArchive(const std::string& name, const IArchive::Ptr& archive, bool isPakFile);
+
+	// (Re-)builds the path index from the registered pak files
+	void buildPathIndex();
+
+	// Returns the archive taking precedence for the given file (or null if not found)
+	IArchive* findArchiveContainingFile(const std::string& filename);
+
+	void showLookupStatistics(const cmd::ArgumentList& args);
+
 	std::shared_ptr<AssetsList> findAssetsList(const std::string& topLevelPath);
 };
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include "iarchive.h"
+#include "idatastream.h"
+#include "gamelib.h"
+#include "stream/BinaryToTextInputStream.h"
+
+namespace archive
+{
+
+/// \brief An InputStream reading from a fixed range of memory
+class MemoryRangeInputStream :
+	public InputStream
+{
+private:
+	const byte_type* _cur;
+	const byte_type* _end;
+
+public:
+	MemoryRangeInputStream(const byte_type* data, size_type size) :
+		_cur(data),
+		_end(data + size)
+	{}
+
+	size_type read(byte_type* buffer, size_type length) override
+	{
+		auto count = std::min(static_cast<size_type>(_end - _cur), length);
+
+		std::memcpy(buffer, _cur, count);
+		_cur += count;
+
+		return count;
+	}
+};
+
+/**
+ * ArchiveFile reading from a block of memory, which is either a view into
+ * a memory-mapped archive (stored files) or the fully inflated file contents
+ * (deflated files). The owner reference keeps the memory block alive.
+ */
+class MappedArchiveFile :
+	public ArchiveFile
+{
+private:
+	std::string _name;
+	std::shared_ptr<const void> _owner;
+	MemoryRangeInputStream _stream;
+	std::size_t _size;
+
+public:
+	MappedArchiveFile(const std::string& name, const std::shared_ptr<const void>& owner,
+					  const InputStream::byte_type* data, std::size_t size) :
+		_name(name),
+		_owner(owner),
+		_stream(data, size),
+		_size(size)
+	{}
+
+	std::size_t size() const override
+	{
+		return _size;
+	}
+
+	const std::string& getName() const override
+	{
+		return _name;
+	}
+
+	InputStream& getInputStream() override
+	{
+		return _stream;
+	}
+};
+
+/// \brief The text file counterpart of MappedArchiveFile
+class MappedArchiveTextFile :
+	public ArchiveTextFile
+{
+private:
+	std::string _name;
+	std::shared_ptr<const void> _owner;
+	MemoryRangeInputStream _stream;
+	stream::BinaryToTextInputStream<MemoryRangeInputStream> _textStream; // converts data from _stream
+
+	// Mod directory containing this file
+	const std::string _modRoot;
+
+public:
+	MappedArchiveTextFile(const std::string& name, const std::string& modRoot,
+						  const std::shared_ptr<const void>& owner,
+						  const InputStream::byte_type* data, std::size_t size) :
+		_name(name),
+		_owner(owner),
+		_stream(data, size),
+		_textStream(_stream),
+		_modRoot(modRoot)
+	{}
+
+	const std::string& getName() const override
+	{
+		return _name;
+	}
+
+	TextInputStream& getInputStream() override
+	{
+		return _textStream;
+	}
+
+	std::string getModName() const override
+	{
+		return game::current::getModPath(_modRoot);
+	}
+};
+
+}
@@ -1,6 +1,8 @@
 #include "ZipArchive.h"
 
+#include <cstring>
 #include <stdexcept>
+#include <vector>
 #include "itextstream.h"
 #include "iarchive.h"
 #include "gamelib.h"
@@ -8,12 +10,14 @@
 
 #include "os/fs.h"
 #include "os/path.h"
+#include "os/MappedFile.h"
 
 #include "ZipStreamUtils.h"
 #include "DeflatedArchiveFile.h"
 #include "DeflatedArchiveTextFile.h"
 #include "StoredArchiveFile.h"
 #include "StoredArchiveTextFile.h"
+#include "MappedArchiveFile.h"
 
 namespace archive
 {
@@ -28,8 +32,20 @@ public:
 	{}
 };
 
+namespace
+{
+	// Size of the fixed part of a local file header, followed by the file name and the extras
+	constexpr std::size_t ZIP_FILE_HEADER_SIZE = 30;
+	constexpr std::size_t ZIP_FILE_HEADER_NAME_LENGTH_OFFSET = 26;
+	constexpr std::size_t ZIP_FILE_HEADER_EXTRAS_OFFSET = 28;
 
-ZipArchive::ZipArchive(const std::string& fullPath) :
+	inline uint16_t readLittleEndianUInt16(const unsigned char* data)
+	{
+		return static_cast<uint16_t>(data[0] | (data[1] << 8));
+	}
+}
+
+ZipArchive::ZipArchive(const std::string& fullPath, bool useMemoryMapping) :
 	_fullPath(fullPath),
 	_containingFolder(os::standardPathWithSlash(fs::path(_fullPath).remove_filename())),
 	_istream(_fullPath)
@@ -48,6 +64,17 @@ ZipArchive::ZipArchive(const std::string& fullPath) :
 	catch (ZipFailureException& ex)
 	{
 		rError() << "Cannot read Zip file " << _fullPath << ": " << ex.what() << std::endl;
+		return;
+	}
+
+	if (useMemoryMapping)
+	{
+		_mappedFile = os::MappedFile::open(_fullPath);
+
+		if (!_mappedFile)
+		{
+			rWarning() << "Cannot map Zip file " << _fullPath << ", falling back to file streams" << std::endl;
+		}
 	}
 }
 
@@ -64,6 +91,20 @@ ArchiveFilePtr ZipArchive::openFile(const std::string& name)
 	{
 		const std::shared_ptr<ZipRecord>& file = i->second.getRecord();
 
+		if (_mappedFile)
+		{
+			std::shared_ptr<const void> owner;
+			const unsigned char* data = nullptr;
+			std::size_t size = 0;
+
+			if (!getMappedFileContents(*file, owner, data, size))
+			{
+				return ArchiveFilePtr();
+			}
+
+			return std::make_shared<MappedArchiveFile>(name, owner, data, size);
+		}
+
 		stream::FileInputStream::size_type position = 0;
 
 		{
@@ -104,6 +145,20 @@ ArchiveTextFilePtr ZipArchive::openTextFile(const std::string& name)
 	{
 		const std::shared_ptr<ZipRecord>& file = i->second.getRecord();
 
+		if (_mappedFile)
+		{
+			std::shared_ptr<const void> owner;
+			const unsigned char* data = nullptr;
+			std::size_t size = 0;
+
+			if (!getMappedFileContents(*file, owner, data, size))
+			{
+				return ArchiveTextFilePtr();
+			}
+
+			return std::make_shared<MappedArchiveTextFile>(name, _containingFolder, owner, data, size);
+		}
+
 		// Guard against concurrent access
 		std::lock_guard<std::mutex> lock(_streamLock);
 
@@ -163,6 +218,82 @@ std::string ZipArchive::getArchivePath(const std::string& relativePath)
 	return _fullPath;
 }
 
+bool ZipArchive::getMappedFileContents(const ZipRecord& record, std::shared_ptr<const void>& owner,
+	const unsigned char*& data, std::size_t& size)
+{
+	const auto* archiveData = _mappedFile->data();
+	auto archiveSize = _mappedFile->size();
+
+	// Locate the file data behind the local header, checking all bounds against the mapping
+	if (record.position > archiveSize || archiveSize - record.position < ZIP_FILE_HEADER_SIZE)
+	{
+		rError() << "Error reading zip file " << _fullPath << std::endl;
+		return false;
+	}
+
+	const auto* header = archiveData + record.position;
+
+	if (std::memcmp(header, ZIP_MAGIC_FILE_HEADER.value, sizeof(ZIP_MAGIC_FILE_HEADER.value)) != 0)
+	{
+		rError() << "Error reading zip file " << _fullPath << std::endl;
+		return false;
+	}
+
+	std::size_t dataOffset = record.position + ZIP_FILE_HEADER_SIZE +
+		readLittleEndianUInt16(header + ZIP_FILE_HEADER_NAME_LENGTH_OFFSET) +
+		readLittleEndianUInt16(header + ZIP_FILE_HEADER_EXTRAS_OFFSET);
+
+	if (dataOffset > archiveSize || archiveSize - dataOffset < record.stream_size)
+	{
+		rError() << "Error reading zip file " << _fullPath << std::endl;
+		return false;
+	}
+
+	if (record.mode == ZipRecord::eStored)
+	{
+		// Stored files are a direct view into the mapping
+		owner = _mappedFile;
+		data = archiveData + dataOffset;
+		size = record.stream_size;
+		return true;
+	}
+
+	// Inflate the whole file at once, straight from the mapped bytes
+	auto buffer = std::make_shared<std::vector<unsigned char>>(record.file_size);
+
+	z_stream zipStream;
+	zipStream.zalloc = nullptr;
+	zipStream.zfree = nullptr;
+	zipStream.opaque = nullptr;
+	zipStream.next_in = const_cast<Bytef*>(archiveData + dataOffset);
+	zipStream.avail_in = record.stream_size;
+	zipStream.next_out = buffer->data();
+	zipStream.avail_out = static_cast<uInt>(buffer->size());
+
+	if (inflateInit2(&zipStream, -MAX_WBITS) != Z_OK)
+	{
+		rError() << "Cannot initialise inflate stream for zip file " << _fullPath << std::endl;
+		return false;
+	}
+
+	auto result = inflate(&zipStream, Z_FINISH);
+
+	if (result != Z_STREAM_END)
+	{
+		// Hand out what could be inflated, like the streamed variant does
+		rWarning() << "Failed to inflate file at offset " << record.position << " in " << _fullPath << std::endl;
+		buffer->resize(zipStream.total_out);
+	}
+
+	inflateEnd(&zipStream);
+
+	owner = buffer;
+	data = buffer->data();
+	size = buffer->size();
+
+	return true;
+}
+
 void ZipArchive::readZipRecord()
 {
 	ZipMagic magic;
@@ -5,6 +5,8 @@
 #include "stream/FileInputStream.h"
 #include <mutex>
 
+namespace os { class MappedFile; }
+
 namespace archive
 {
 
@@ -16,6 +18,12 @@ namespace archive
  * physical directories.
  *
  * Archives are owned and instantiated by the GlobalFileSystem instance.
+ *
+ * If memory mapping is requested (and succeeds), the files are read straight
+ * from the mapped archive without taking any lock: stored files are returned as
+ * views into the mapping, deflated files are inflated into a buffer of their
+ * final size in one go. This allows several threads to load from the same
+ * archive at once. Otherwise each opened file gets its own file stream.
  */
 class ZipArchive final :
 	public IArchive
@@ -54,8 +62,11 @@ private:
 	stream::FileInputStream _istream;
 	std::mutex _streamLock;
 
+	// Non-empty if this archive is read through a memory mapping
+	std::shared_ptr<os::MappedFile> _mappedFile;
+
 public:
-	ZipArchive(const std::string& fullPath);
+	ZipArchive(const std::string& fullPath, bool useMemoryMapping = false);
 	virtual ~ZipArchive();
 
 	// Archive implementation
@@ -71,6 +82,12 @@ public:
 private:
 	void readZipRecord();
 	void loadZipFile();
+
+	// Returns the block of mapped memory holding the (uncompressed) contents of the given
+	// file, inflating it if necessary. The returned owner keeps the block alive.
+	// Returns false if the local file header is corrupt.
+	bool getMappedFileContents(const ZipRecord& record, std::shared_ptr<const void>& owner,
+		const unsigned char*& data, std::size_t& size);
 };
 
 }
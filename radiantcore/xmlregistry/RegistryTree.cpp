@@ -23,7 +23,7 @@ RegistryTree::RegistryTree(const RegistryTree& other) :
 {
 }
 
-std::string RegistryTree::prepareKey(const std::string& key)
+std::string RegistryTree::prepareKey(const std::string& key) const
 {
 	if (key.empty())
 	{
@@ -42,7 +42,7 @@ std::string RegistryTree::prepareKey(const std::string& key)
 	}
 }
 
-xml::NodeList RegistryTree::findXPath(const std::string& xPath)
+xml::NodeList RegistryTree::findXPath(const std::string& xPath) const
 {
 	return _tree.findXPath(prepareKey(xPath));
 }
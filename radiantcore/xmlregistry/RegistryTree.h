@@ -25,7 +25,7 @@ public:
 	RegistryTree(const RegistryTree& other);
 
 	// Returns a list of nodes matching the given <xpath>
-	xml::NodeList findXPath(const std::string& xPath);
+	xml::NodeList findXPath(const std::string& xPath) const;
 
 	//	Checks whether a key exists in the XMLRegistry by querying the XPath
 	bool keyExists(const std::string& key);
@@ -67,7 +67,7 @@ private:
 	 * Absolute paths are returned unchanged, a prefix with the
 	 * toplevel node (e.g. "/worldedit") is appended to the relative ones.
 	 */
-	std::string prepareKey(const std::string& key);
+	std::string prepareKey(const std::string& key) const;
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 #include "itextstream.h"
 
 #include "os/file.h"
@@ -10,6 +11,7 @@
 #include "version.h"
 #include "string/string.h"
 #include "string/encoding.h"
+#include "string/predicate.h"
 #include "module/StaticModule.h"
 #include "settings/SettingsManager.h"
 
@@ -19,10 +21,42 @@ namespace registry
 namespace
 {
 	const char* const RKEY_SKIP_REGISTRY_SAVE = "user/skipRegistrySaveOnShutdown";
+
+	// The number of most frequently evaluated keys listed in the statistics
+	const std::size_t NUM_REPORTED_XPATH_KEYS = 10;
+
+	// Returns the key as used in the index, or an empty string if the
+	// key is an XPath expression whose result can't be indexed
+	std::string getIndexKey(const std::string& key)
+	{
+		if (key.empty() || key.find_first_of("[]*@()|=:") != std::string::npos ||
+			key.find("//") != std::string::npos || key.find("..") != std::string::npos)
+		{
+			return std::string();
+		}
+
+		// Absolute paths below the toplevel node refer to the same node as relative ones
+		const std::string toplevelPrefix = std::string("/") + TOPLEVEL_NODE_NAME + "/";
+
+		if (string::starts_with(key, toplevelPrefix))
+		{
+			return key.substr(toplevelPrefix.length());
+		}
+
+		return key[0] == '/' ? std::string() : key;
+	}
+
+	std::string getAttributeIndexKey(const std::string& indexKey, const std::string& attrName)
+	{
+		return indexKey + "/@" + attrName;
+	}
 }
 
 XMLRegistry::XMLRegistry() :
 	_queryCounter(0),
+	_keyIndexGeneration(0),
+	_xpathEvaluations(0),
+	_reportXPathStatistics(false),
 	_changesSinceLastSave(0),
 	_shutdown(false)
 {}
@@ -87,6 +121,27 @@ void XMLRegistry::saveToDisk()
 
 xml::NodeList XMLRegistry::findXPath(const std::string& path)
 {
+	// The returned nodes can be modified by the caller
+	clearKeyIndex();
+
+	return evaluateXPath(path);
+}
+
+xml::NodeList XMLRegistry::findXPathReadOnly(const std::string& path) const
+{
+	return evaluateXPath(path);
+}
+
+xml::NodeList XMLRegistry::evaluateXPath(const std::string& path) const
+{
+	_xpathEvaluations++;
+
+	if (_reportXPathStatistics)
+	{
+		std::lock_guard<std::mutex> lock(_xpathKeysLock);
+		_xpathKeys[path]++;
+	}
+
 	// Query the user tree first
 	xml::NodeList results = _userTree.findXPath(path);
 	xml::NodeList stdResults = _standardTree.findXPath(path);
@@ -120,8 +175,8 @@ sigc::signal<void> XMLRegistry::signalForKey(const std::string& key) const
 
 bool XMLRegistry::keyExists(const std::string& key)
 {
-	// Pass the query on to findXPath which queries the subtrees
-	xml::NodeList result = findXPath(key);
+	// Pass the query on to evaluateXPath which queries the subtrees
+	xml::NodeList result = evaluateXPath(key);
 	return !result.empty();
 }
 
@@ -134,6 +189,8 @@ void XMLRegistry::deleteXPath(const std::string& path)
 	auto numDeletedNodes = _userTree.deleteXPath(path);
 	numDeletedNodes += _standardTree.deleteXPath(path);
 
+	clearKeyIndex();
+
 	if (numDeletedNodes > 0)
 	{
 		_changesSinceLastSave++;
@@ -150,6 +207,9 @@ xml::Node XMLRegistry::createKeyWithName(const std::string& path,
 
 	_changesSinceLastSave++;
 
+	// The returned node can be modified by the caller
+	clearKeyIndex();
+
 	// The key will be created in the user tree (the default tree is read-only)
 	return _userTree.createKeyWithName(path, key, name);
 }
@@ -162,6 +222,9 @@ xml::Node XMLRegistry::createKey(const std::string& key)
 
 	_changesSinceLastSave++;
 
+	// The returned node can be modified by the caller
+	clearKeyIndex();
+
 	return _userTree.createKey(key);
 }
 
@@ -175,28 +238,91 @@ void XMLRegistry::setAttribute(const std::string& path,
 	_changesSinceLastSave++;
 
 	_userTree.setAttribute(path, attrName, attrValue);
+
+	if (auto indexKey = getIndexKey(path); !indexKey.empty())
+	{
+		std::lock_guard<std::mutex> indexLock(_keyIndexLock);
+
+		// The key value doesn't change, but the key might just have been created
+		_keyIndex.erase(indexKey);
+		_keyIndex[getAttributeIndexKey(indexKey, attrName)] = attrValue;
+		_keyIndexGeneration++;
+	}
+	else
+	{
+		clearKeyIndex();
+	}
 }
 
 std::string XMLRegistry::getAttribute(const std::string& path, const std::string& attrName)
 {
-	// Pass the query to the findXPath method, which queries the user tree first
-	if (xml::NodeList nodeList = findXPath(path); !nodeList.empty()) {
-		return nodeList[0].getAttributeValue(attrName);
-	}
-	return std::string();
+	auto indexKey = getIndexKey(path);
+
+	// Pass the query to evaluateXPath, which queries the user tree first
+	return getIndexedValue(indexKey.empty() ? indexKey : getAttributeIndexKey(indexKey, attrName), path,
+		[&](const xml::NodeList& nodeList)
+	{
+		return nodeList.empty() ? std::string() : nodeList[0].getAttributeValue(attrName);
+	});
 }
 
 std::string XMLRegistry::get(const std::string& key)
 {
-	if (const xml::NodeList nodeList = findXPath(key); !nodeList.empty()) {
-		if (const auto content = nodeList[0].getContent(); !content.empty()) {
-			return string::utf8_to_mb(content);
+	return getIndexedValue(getIndexKey(key), key, [](const xml::NodeList& nodeList)
+	{
+		if (!nodeList.empty()) {
+			if (const auto content = nodeList[0].getContent(); !content.empty()) {
+				return string::utf8_to_mb(content);
+			}
+			else {
+				return string::utf8_to_mb(nodeList[0].getAttributeValue("value"));
+			}
 		}
-		else {
-			return string::utf8_to_mb(nodeList[0].getAttributeValue("value"));
+		return std::string();
+	});
+}
+
+std::string XMLRegistry::getIndexedValue(const std::string& indexKey, const std::string& path,
+	const std::function<std::string(const xml::NodeList&)>& resolve)
+{
+	// Queries evaluating the XPath are counted by evaluateXPath()
+	if (indexKey.empty())
+	{
+		return resolve(evaluateXPath(path));
+	}
+
+	std::size_t generation;
+
+	{
+		std::lock_guard<std::mutex> lock(_keyIndexLock);
+
+		if (auto found = _keyIndex.find(indexKey); found != _keyIndex.end())
+		{
+			_queryCounter++;
+			return found->second;
 		}
+
+		generation = _keyIndexGeneration;
+	}
+
+	auto value = resolve(evaluateXPath(path));
+
+	std::lock_guard<std::mutex> lock(_keyIndexLock);
+
+	// Don't store the value if the trees have been changed in the meantime
+	if (generation == _keyIndexGeneration)
+	{
+		_keyIndex.emplace(indexKey, value);
 	}
-	return {};
+
+	return value;
+}
+
+void XMLRegistry::clearKeyIndex()
+{
+	std::lock_guard<std::mutex> lock(_keyIndexLock);
+	_keyIndex.clear();
+	_keyIndexGeneration++;
 }
 
 void XMLRegistry::set(const std::string& key, const std::string& value)
@@ -211,6 +337,27 @@ void XMLRegistry::set(const std::string& key, const std::string& value)
 		_userTree.set(key, string::mb_to_utf8(value));
 
 		_changesSinceLastSave++;
+
+		if (auto indexKey = getIndexKey(key); !indexKey.empty())
+		{
+			std::lock_guard<std::mutex> indexLock(_keyIndexLock);
+
+			_keyIndex[indexKey] = value;
+			_keyIndexGeneration++;
+
+			// The legacy value attribute is gone, and any missing parents have been created
+			_keyIndex.erase(getAttributeIndexKey(indexKey, "value"));
+
+			for (auto slash = indexKey.rfind('/'); slash != std::string::npos && slash > 0;
+				slash = indexKey.rfind('/', slash - 1))
+			{
+				_keyIndex.erase(indexKey.substr(0, slash));
+			}
+		}
+		else
+		{
+			clearKeyIndex();
+		}
 	}
 
 	// Notify the observers
@@ -233,6 +380,9 @@ void XMLRegistry::import(const std::string& importFilePath, const std::string& p
 			break;
 	}
 
+	// Imported keys overwrite previous ones
+	clearKeyIndex();
+
 	_changesSinceLastSave++;
 }
 
@@ -307,6 +457,9 @@ void XMLRegistry::initialiseModule(const IApplicationContext& ctx)
 		if (get("user/debug") == "1")
 		{
 			import(base + "debug.xml", "", Registry::treeStandard);
+
+			// Report the XPath evaluations which couldn't be served from the key index
+			_reportXPathStatistics = true;
 		}
 	}
 	catch (std::runtime_error& e)
@@ -342,6 +495,11 @@ void XMLRegistry::shutdownModule()
 
 void XMLRegistry::onAutoSaveTimerIntervalReached()
 {
+	if (_reportXPathStatistics)
+	{
+		reportXPathStatistics();
+	}
+
 	{
 		std::lock_guard<std::mutex> lock(_writeLock);
 		if (_changesSinceLastSave == 0) {
@@ -352,6 +510,34 @@ void XMLRegistry::onAutoSaveTimerIntervalReached()
 	saveToDisk();
 }
 
+void XMLRegistry::reportXPathStatistics()
+{
+	auto msecs = std::max<std::size_t>(_xpathStatisticsTimer.getMilliSecondsPassed(), 1);
+	_xpathStatisticsTimer.restart();
+
+	auto numEvaluations = _xpathEvaluations.exchange(0);
+
+	if (numEvaluations == 0) return;
+
+	std::vector<std::pair<std::string, std::size_t>> keys;
+
+	{
+		std::lock_guard<std::mutex> lock(_xpathKeysLock);
+		keys.assign(_xpathKeys.begin(), _xpathKeys.end());
+		_xpathKeys.clear();
+	}
+
+	rMessage() << "XMLRegistry: " << (numEvaluations * 1000 / msecs) << " XPath evaluations per second" << std::endl;
+
+	// List the most frequently evaluated keys first
+	std::sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+	for (std::size_t i = 0; i < keys.size() && i < NUM_REPORTED_XPATH_KEYS; ++i)
+	{
+		rMessage() << "  " << keys[i].second << "x " << keys[i].first << std::endl;
+	}
+}
+
 // Static module instance
 module::StaticModuleRegistration<XMLRegistry> xmlRegistryModule;
 
@@ -24,10 +24,14 @@
 #include "iregistry.h"
 #include <map>
 #include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <functional>
 
 #include "imodule.h"
 #include "RegistryTree.h"
 #include "time/Timer.h"
+#include "time/StopWatch.h"
 
 namespace settings { class SettingsManager; }
 
@@ -51,7 +55,29 @@ private:
 	RegistryTree _userTree;
 
 	// The query counter for some statistics :)
-	unsigned int _queryCounter;
+	mutable std::atomic<unsigned int> _queryCounter;
+
+	// Resolved values of plain key paths (and their attributes), such that
+	// repeated lookups of the same key don't need to evaluate any XPath.
+	// Entries are updated by set() and setAttribute(), everything else
+	// touching the trees or handing out writable nodes drops the whole index.
+	std::unordered_map<std::string, std::string> _keyIndex;
+	std::mutex _keyIndexLock;
+
+	// Incremented on every change of the index, lookups racing with a
+	// change don't store the value they resolved before it
+	std::size_t _keyIndexGeneration;
+
+	// Number of XPath evaluations since the last statistics report
+	mutable std::atomic<unsigned int> _xpathEvaluations;
+
+	// TRUE if the XPath evaluations should be reported (user/debug is set)
+	bool _reportXPathStatistics;
+
+	// The keys which needed an XPath evaluation since the last report
+	mutable std::map<std::string, std::size_t> _xpathKeys;
+	mutable std::mutex _xpathKeysLock;
+	util::StopWatch _xpathStatisticsTimer;
 
 	// Change tracking counter, is reset when saveToDisk() is called
 	unsigned int _changesSinceLastSave;
@@ -73,6 +99,7 @@ public:
 	XMLRegistry();
 
 	xml::NodeList findXPath(const std::string& path) override;
+	xml::NodeList findXPathReadOnly(const std::string& path) const override;
 
 	/*	Checks whether a key exists in the XMLRegistry by querying the XPath
 	 */
@@ -136,6 +163,19 @@ private:
 
 	void emitSignalForKey(const std::string& changedKey);
 
+	// Queries both trees without touching the key index
+	xml::NodeList evaluateXPath(const std::string& path) const;
+
+	// Returns the value of the given key index entry, evaluating the
+	// XPath once and storing the result if it's not indexed yet
+	std::string getIndexedValue(const std::string& indexKey, const std::string& path,
+		const std::function<std::string(const xml::NodeList&)>& resolve);
+
+	// Removes all entries from the key index
+	void clearKeyIndex();
+
+	void reportXPathStatistics();
+
 	// Invoked after all modules have been uninitialised
 	void shutdown();
 